@@ -0,0 +1,166 @@
+/******************************
+* Authors:
+* Marco Varela
+* Purpose:
+* Ordering shots by hang time and flying them in lanes
+*******************************/
+
+#include "batchPlanner.h"
+#include "surrogate.h"
+#include "dragTable.h"
+#include <algorithm>
+using namespace std;
+
+
+/**************************************
+THE LANES, STRUCTURE OF ARRAYS
+***************************************/
+struct laneState
+{
+   vector <double> x;
+   vector <double> y;
+   vector <double> dx;
+   vector <double> dy;
+   vector <double> hang;
+   vector <double> previousX;
+   vector <double> previousY;
+   vector <double> previousHang;
+   vector <double> apex;
+   vector <int> shot;     // index of the shot in the lane, -1 if idle
+
+   laneState(int lanes) :
+      x(lanes), y(lanes), dx(lanes), dy(lanes), hang(lanes),
+      previousX(lanes), previousY(lanes), previousHang(lanes), apex(lanes), shot(lanes, -1)
+   {
+   }
+};
+
+
+/**************************************
+PUT A SHOT IN A LANE
+***************************************/
+static void loadLane(laneState & state, int lane, int shot, const batchShot & what)
+{
+   shellState shell = launchShell(what.angle, what.muzzleVelocity);
+   state.x[lane] = shell.x;
+   state.y[lane] = shell.y;
+   state.dx[lane] = shell.dx;
+   state.dy[lane] = shell.dy;
+   state.hang[lane] = shell.hang;
+   state.apex[lane] = 0.0;
+   state.shot[lane] = shot;
+}
+
+
+/**************************************
+BATCH PLANNER : CONSTRUCTOR
+***************************************/
+BatchPlanner::BatchPlanner(int lanes, double timeInterval) :
+   lanes(lanes < 1 ? 1 : lanes), timeInterval(timeInterval), surrogate(NULL)
+{
+}
+
+
+/**************************************
+BATCH PLANNER : ESTIMATE A HANG TIME
+***************************************/
+double BatchPlanner::estimateHangTime(const batchShot & shot) const
+{
+   if (surrogate != NULL)
+   {
+      surrogateEstimate estimate = surrogate->evaluate(shot.angle, shot.muzzleVelocity);
+      if (estimate.inDomain)
+         return estimate.value.hangTime;
+   }
+
+   // up and back down with no air, which keeps the order if not the value
+   double dy = computeVerticalComponent(Angle(shot.angle), shot.muzzleVelocity);
+   return 2.0 * dy / -gravityFromAltitude(0.0);
+}
+
+
+/**************************************
+BATCH PLANNER : ORDER THE SHOTS
+***************************************/
+vector <int> BatchPlanner::plan(const vector <batchShot> & shots) const
+{
+   vector <pair <double, int> > estimates;
+   for (int i = 0; i < (int)shots.size(); i++)
+      estimates.push_back(make_pair(-estimateHangTime(shots[i]), i));
+   // stable on ties, so the same list always plans the same way
+   stable_sort(estimates.begin(), estimates.end());
+
+   vector <int> order;
+   for (size_t i = 0; i < estimates.size(); i++)
+      order.push_back(estimates[i].second);
+   return order;
+}
+
+
+/**************************************
+BATCH PLANNER : FLY THE SHOTS
+***************************************/
+batchReport BatchPlanner::run(const vector <batchShot> & shots, vector <trajectorySummary> & results,
+                              bool sorted, bool refill) const
+{
+   vector <int> order;
+   if (sorted)
+      order = plan(shots);
+   else
+      for (int i = 0; i < (int)shots.size(); i++)
+         order.push_back(i);
+
+   const DragTable & table = defaultDragTable();
+
+   results.assign(shots.size(), trajectorySummary());
+   batchReport report = {};
+   laneState state(lanes);
+   size_t next = 0;
+   int active = 0;
+
+   while (active > 0 || next < order.size())
+   {
+      // Without refill a new batch only starts once the whole last one has landed
+      if (active == 0 || refill)
+         for (int lane = 0; lane < lanes && next < order.size(); lane++)
+            if (state.shot[lane] == -1)
+            {
+               loadLane(state, lane, order[next], shots[order[next]]);
+               next++;
+               active++;
+            }
+
+      // One step of every lane, the same arithmetic stepShellTable runs
+      for (int lane = 0; lane < lanes; lane++)
+      {
+         if (state.shot[lane] == -1)
+            continue;
+         state.previousX[lane] = state.x[lane];
+         state.previousY[lane] = state.y[lane];
+         state.previousHang[lane] = state.hang[lane];
+
+         advanceWithTable(table, state.x[lane], state.y[lane], state.dx[lane], state.dy[lane],
+                          state.hang[lane], timeInterval);
+         if (state.y[lane] > state.apex[lane])
+            state.apex[lane] = state.y[lane];
+      }
+      report.steps++;
+      report.laneSteps += lanes;
+      report.activeLaneSteps += active;
+
+      // Land what hit the ground and free the lane
+      for (int lane = 0; lane < lanes; lane++)
+      {
+         if (state.shot[lane] == -1 || state.y[lane] >= 0)
+            continue;
+         shellState previous = { state.previousX[lane], state.previousY[lane], 0.0, 0.0, state.previousHang[lane] };
+         shellState shell = { state.x[lane], state.y[lane], 0.0, 0.0, state.hang[lane] };
+         results[state.shot[lane]] = landShell(previous, shell, state.apex[lane]);
+         state.shot[lane] = -1;
+         active--;
+      }
+   }
+
+   report.utilization = report.laneSteps > 0 ? (double)report.activeLaneSteps / report.laneSteps : 1.0;
+   return report;
+}
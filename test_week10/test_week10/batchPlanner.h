@@ -0,0 +1,71 @@
+/***********************************************************************
+ * Header File:
+ *    Batch Planner : Keep every lane of a batch busy
+ * Author:
+ *    Marco Varela
+ * Summary:
+ *    Flies many shots a fixed number of lanes at a time, the lanes
+ *    stepped together in one loop over structure of arrays state. Shots
+ *    are ordered longest estimated hang time first and a lane that lands
+ *    is refilled from the queue right away, so short flights do not
+ *    leave lanes idle while the longest shell in the batch finishes
+ ************************************************************************/
+
+#pragma once
+#include "simulation.h"
+
+class Surrogate;
+
+
+/*********************************************
+ * STRUCTURE - BATCH SHOT
+ *********************************************/
+struct batchShot
+{
+   double angle;
+   double muzzleVelocity;
+};
+
+
+/*********************************************
+ * STRUCTURE - BATCH REPORT
+ * How well the lanes were used
+ *********************************************/
+struct batchReport
+{
+   long steps;            // passes over the lanes
+   long laneSteps;        // steps times lanes
+   long activeLaneSteps;  // lane steps that moved a shell
+   double utilization;    // active over total
+};
+
+
+/*****************************************************
+ * BATCH PLANNER
+ * Works on shots, not targets. A solver working on many targets
+ * hands it the shots of one round at a time
+ *****************************************************/
+class BatchPlanner
+{
+public:
+   BatchPlanner(int lanes = 8, double timeInterval = 0.01);
+
+   // Estimate hang times with a fitted surrogate where it covers the shot
+   void setSurrogate(const Surrogate * surrogate) { this->surrogate = surrogate; }
+
+   // The surrogate's hang time, or the vacuum hang time when it has none
+   double estimateHangTime(const batchShot & shot) const;
+
+   // Indexes into shots, longest estimated flight first
+   vector <int> plan(const vector <batchShot> & shots) const;
+
+   // Fly every shot with the drag table step. results lines up with shots.
+   // sorted and refill can be turned off to see what they buy
+   batchReport run(const vector <batchShot> & shots, vector <trajectorySummary> & results,
+                   bool sorted = true, bool refill = true) const;
+
+private:
+   int lanes;
+   double timeInterval;
+   const Surrogate * surrogate;
+};
@@ -0,0 +1,241 @@
+/******************************
+* Authors:
+* Marco Varela
+* Purpose:
+* Measuring integrator error against a high precision reference
+*******************************/
+
+#include "convergence.h"
+#include "dragTable.h"
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+using namespace std;
+
+// keep timing a variant until this much wall time has gone by
+const double MIN_TIMING_SECONDS = 0.05;
+
+
+/**************************************
+THE REFERENCE STATE, IN LONG DOUBLE
+***************************************/
+struct referenceState
+{
+   long double x;
+   long double y;
+   long double dx;
+   long double dy;
+};
+
+
+/**************************************
+ACCELERATION AT A REFERENCE STATE
+* The tables are double, so the lookups are too. What the reference
+* buys is the integration, which is where the step error comes from
+***************************************/
+static void referenceAcceleration(const referenceState & state, long double & ddx, long double & ddy)
+{
+   shellState shell = { (double)state.x, (double)state.y, (double)state.dx, (double)state.dy, 0.0 };
+   double ax;
+   double ay;
+   computeAcceleration(shell, ax, ay);
+   ddx = ax;
+   ddy = ay;
+}
+
+
+/**************************************
+FLY THE REFERENCE SHOT
+***************************************/
+trajectorySummary referenceShot(double angle, double muzzleVelocity, long double timeInterval)
+{
+   shellState launch = launchShell(angle, muzzleVelocity);
+   referenceState state = { 0.0L, 0.0L, launch.dx, launch.dy };
+   referenceState previous = state;
+   long double hang = 0.0L;
+   long double apex = 0.0L;
+   long double half = timeInterval * 0.5L;
+
+   while (state.y >= 0)
+   {
+      previous = state;
+
+      // fourth order Runge-Kutta
+      referenceState stage = state;
+      long double vx[4];
+      long double vy[4];
+      long double ax[4];
+      long double ay[4];
+      vx[0] = state.dx;
+      vy[0] = state.dy;
+      referenceAcceleration(stage, ax[0], ay[0]);
+      for (int k = 1; k < 4; k++)
+      {
+         long double h = (k == 3) ? timeInterval : half;
+         stage.x = state.x + vx[k - 1] * h;
+         stage.y = state.y + vy[k - 1] * h;
+         stage.dx = state.dx + ax[k - 1] * h;
+         stage.dy = state.dy + ay[k - 1] * h;
+         vx[k] = stage.dx;
+         vy[k] = stage.dy;
+         referenceAcceleration(stage, ax[k], ay[k]);
+      }
+      long double sixth = timeInterval / 6.0L;
+      state.x += sixth * (vx[0] + 2.0L * vx[1] + 2.0L * vx[2] + vx[3]);
+      state.y += sixth * (vy[0] + 2.0L * vy[1] + 2.0L * vy[2] + vy[3]);
+      state.dx += sixth * (ax[0] + 2.0L * ax[1] + 2.0L * ax[2] + ax[3]);
+      state.dy += sixth * (ay[0] + 2.0L * ay[1] + 2.0L * ay[2] + ay[3]);
+      hang += timeInterval;
+      if (state.y > apex)
+         apex = state.y;
+   }
+
+   // The 0 represents the ground (altitude 0)
+   long double fraction = previous.y / (previous.y - state.y);
+   trajectorySummary summary;
+   summary.distance = (double)(previous.x + (state.x - previous.x) * fraction);
+   summary.hangTime = (double)(hang - timeInterval + timeInterval * fraction);
+   summary.apex = (double)apex;
+   return summary;
+}
+
+
+/**************************************
+THE SHOTS THE TOOL USES
+***************************************/
+vector <convergenceShot> defaultConvergenceShots()
+{
+   vector <convergenceShot> shots;
+   convergenceShot howitzer = { 75.0, 827.0 };
+   convergenceShot steep = { 20.0, 827.0 };
+   convergenceShot subsonic = { 45.0, 300.0 };
+   convergenceShot flat = { 85.0, 600.0 };
+   shots.push_back(howitzer);
+   shots.push_back(steep);
+   shots.push_back(subsonic);
+   shots.push_back(flat);
+   return shots;
+}
+
+
+/**************************************
+THE VARIANTS THE TOOL COMPARES
+***************************************/
+vector <convergenceVariant> defaultConvergenceVariants()
+{
+   vector <convergenceVariant> variants;
+   convergenceVariant repo = { "stepShell", stepShell };
+   convergenceVariant rk4 = { "rk4", stepShellRK4 };
+   convergenceVariant table = { "dragTable", stepShellTable };
+   variants.push_back(repo);
+   variants.push_back(rk4);
+   variants.push_back(table);
+   return variants;
+}
+
+
+/**************************************
+THE TIME INTERVALS THE TOOL TRIES
+***************************************/
+vector <double> defaultConvergenceIntervals()
+{
+   const double intervals[] = { 0.001, 0.0025, 0.005, 0.01, 0.02, 0.05, 0.1 };
+   return vector <double>(intervals, intervals + sizeof(intervals) / sizeof(intervals[0]));
+}
+
+
+/**************************************
+RUN EVERY VARIANT AGAINST THE REFERENCE
+***************************************/
+vector <convergenceResult> runConvergence(const vector <convergenceShot> & shots,
+                                          const vector <convergenceVariant> & variants,
+                                          const vector <double> & timeIntervals,
+                                          long double referenceInterval)
+{
+   vector <trajectorySummary> references;
+   for (size_t i = 0; i < shots.size(); i++)
+      references.push_back(referenceShot(shots[i].angle, shots[i].muzzleVelocity, referenceInterval));
+
+   vector <convergenceResult> results;
+   for (size_t v = 0; v < variants.size(); v++)
+      for (size_t t = 0; t < timeIntervals.size(); t++)
+      {
+         convergenceResult result;
+         result.name = variants[v].name;
+         result.timeInterval = timeIntervals[t];
+         result.distanceError = 0.0;
+         result.hangTimeError = 0.0;
+
+         int passes = 0;
+         chrono::steady_clock::time_point start = chrono::steady_clock::now();
+         chrono::duration <double> elapsed(0.0);
+         while (passes == 0 || elapsed.count() < MIN_TIMING_SECONDS)
+         {
+            for (size_t i = 0; i < shots.size(); i++)
+            {
+               trajectorySummary summary = simulateShot(shots[i].angle, shots[i].muzzleVelocity,
+                                                        timeIntervals[t], variants[v].step);
+               result.distanceError = max(result.distanceError, fabs(summary.distance - references[i].distance));
+               result.hangTimeError = max(result.hangTimeError, fabs(summary.hangTime - references[i].hangTime));
+            }
+            passes++;
+            elapsed = chrono::steady_clock::now() - start;
+         }
+         result.seconds = elapsed.count() / passes;
+         results.push_back(result);
+      }
+   return results;
+}
+
+
+/**************************************
+FASTEST RESULT WITHIN TOLERANCE
+***************************************/
+int cheapestWithin(const vector <convergenceResult> & results, double distanceTolerance, double hangTimeTolerance)
+{
+   int best = -1;
+   for (int i = 0; i < (int)results.size(); i++)
+      if (results[i].distanceError <= distanceTolerance &&
+          results[i].hangTimeError <= hangTimeTolerance &&
+          (best == -1 || results[i].seconds < results[best].seconds))
+         best = i;
+   return best;
+}
+
+
+/**************************************
+SORT RESULTS BY WALL TIME
+***************************************/
+static bool fasterResult(const convergenceResult & lhs, const convergenceResult & rhs)
+{
+   return lhs.seconds < rhs.seconds;
+}
+
+
+/**************************************
+PRINT THE CHART
+***************************************/
+void printConvergence(const vector <convergenceResult> & results, double distanceTolerance,
+                      double hangTimeTolerance, ostream & out)
+{
+   vector <convergenceResult> sorted = results;
+   sort(sorted.begin(), sorted.end(), fasterResult);
+   int best = cheapestWithin(sorted, distanceTolerance, hangTimeTolerance);
+
+   out << "variant        step(s)   time(ms)   distance err(m)  hang err(s)   distance err, 1 mm to 10 km\n";
+   for (int i = 0; i < (int)sorted.size(); i++)
+   {
+      // one mark per factor of ten above a millimeter
+      int marks = (int)floor(log10(sorted[i].distanceError + 1e-12) + 3.0);
+      marks = max(0, min(marks, 7));
+      out << left << setw(13) << sorted[i].name << right
+          << fixed << setprecision(4) << setw(9) << sorted[i].timeInterval
+          << setprecision(3) << setw(11) << sorted[i].seconds * 1000.0
+          << setprecision(4) << setw(18) << sorted[i].distanceError
+          << setprecision(5) << setw(13) << sorted[i].hangTimeError
+          << "   |" << string(marks * 4, '#')
+          << (i == best ? "  <- cheapest within tolerance" : "") << '\n';
+   }
+   if (best == -1)
+      out << "Nothing meets " << distanceTolerance << " m and " << hangTimeTolerance << " s\n";
+}
@@ -0,0 +1,76 @@
+/***********************************************************************
+ * Header File:
+ *    Convergence : How much error each way of stepping costs us
+ * Author:
+ *    Marco Varela
+ * Summary:
+ *    Flies a set of shots with a long double, tiny step reference and
+ *    then with every integrator, time interval and lookup variant we
+ *    might use. Reports the worst distance and hang time error next to
+ *    the wall time so we can pick the cheapest setup within tolerance
+ ************************************************************************/
+
+#pragma once
+#include <string>
+#include "simulation.h"
+
+
+/*********************************************
+ * STRUCTURE - CONVERGENCE SHOT
+ *********************************************/
+struct convergenceShot
+{
+   double angle;
+   double muzzleVelocity;
+};
+
+
+/*********************************************
+ * STRUCTURE - CONVERGENCE VARIANT
+ * An integrator or lookup table choice with a name for the report
+ *********************************************/
+struct convergenceVariant
+{
+   string name;
+   stepFunction step;
+};
+
+
+/*********************************************
+ * STRUCTURE - CONVERGENCE RESULT
+ * One variant at one time interval, worst case over the shots
+ *********************************************/
+struct convergenceResult
+{
+   string name;
+   double timeInterval;
+   double distanceError;   // m
+   double hangTimeError;   // s
+   double seconds;         // wall time to fly all the shots once
+};
+
+
+// Fly a shot with Runge-Kutta in long double. Slow, only for reference
+trajectorySummary referenceShot(double angle, double muzzleVelocity, long double timeInterval = 1e-4L);
+
+
+// The shots, variants and time intervals the tool uses
+vector <convergenceShot> defaultConvergenceShots();
+vector <convergenceVariant> defaultConvergenceVariants();
+vector <double> defaultConvergenceIntervals();
+
+
+// Every variant at every time interval against the reference
+vector <convergenceResult> runConvergence(const vector <convergenceShot> & shots,
+                                          const vector <convergenceVariant> & variants,
+                                          const vector <double> & timeIntervals,
+                                          long double referenceInterval = 1e-4L);
+
+
+// Index of the fastest result within both tolerances, -1 if none are
+int cheapestWithin(const vector <convergenceResult> & results, double distanceTolerance, double hangTimeTolerance);
+
+
+// Table sorted by wall time, error drawn as a bar on a log scale
+void printConvergence(const vector <convergenceResult> & results, double distanceTolerance,
+                      double hangTimeTolerance, ostream & out);
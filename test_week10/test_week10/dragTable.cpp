@@ -0,0 +1,193 @@
+/******************************
+* Authors:
+* Marco Varela
+* Purpose:
+* Building and reading the 2D drag table
+*******************************/
+
+#include "dragTable.h"
+#include <memory>
+#include <mutex>
+using namespace std;
+
+
+/**************************************
+DRAG TABLE : CONSTRUCTOR
+***************************************/
+DragTable::DragTable(double mass, double area, double altitudeMax, double altitudeStep,
+                     double speedMax, double speedStep) :
+   mass(mass), area(area), altitudeStep(altitudeStep), speedStep(speedStep),
+   rows((int)ceil(altitudeMax / altitudeStep) + 1),
+   columns((int)ceil(speedMax / speedStep) + 1),
+   builds(0)
+{
+   build();
+}
+
+
+/**************************************
+DRAG TABLE : CHANGE THE SHELL
+***************************************/
+void DragTable::setShell(double mass, double area)
+{
+   if (mass == this->mass && area == this->area)
+      return;
+   this->mass = mass;
+   this->area = area;
+   build();
+}
+
+
+/**************************************
+DRAG TABLE : REBUILD FOR NEW MET DATA
+* Compared by value, so setting the same met data again, or nudging
+* it and putting it back, does not cost a rebuild
+***************************************/
+void DragTable::rebuildIfStale()
+{
+   if (!isBuiltFor(getMetData()))
+      build();
+}
+
+
+/**************************************
+DRAG TABLE : THE FULL CHAIN FOR ONE POINT
+***************************************/
+double DragTable::dragPerSpeedSquaredChain(double altitude, double speed) const
+{
+   double dragCoefficient = dragFromMach(speed / speedOfSoundFromAltitude(altitude));
+   double densityOfAir = densityFromAltitude(altitude);
+   // the drag force at 1 m/s is the force divided by v squared
+   return calculateDragForce(dragCoefficient, densityOfAir, 1.0, area) / mass;
+}
+
+
+/**************************************
+DRAG TABLE : FILL THE GRID
+***************************************/
+void DragTable::build()
+{
+   grid.resize(rows * columns);
+   for (int i = 0; i < rows; i++)
+      for (int j = 0; j < columns; j++)
+         grid[i * columns + j] = dragPerSpeedSquaredChain(i * altitudeStep, j * speedStep);
+   builtWith = getMetData();
+   builds++;
+}
+
+
+/**************************************
+DRAG TABLE : BILINEAR LOOKUP
+***************************************/
+double DragTable::dragPerSpeedSquared(double altitude, double speed) const
+{
+   // below the ground and above the top the edge rows are used, like linearInterpolation
+   double a = altitude / altitudeStep;
+   double s = speed / speedStep;
+   if (a < 0.0)
+      a = 0.0;
+   if (s < 0.0)
+      s = 0.0;
+   int i = (int)a;
+   int j = (int)s;
+   if (i > rows - 2)
+      i = rows - 2;
+   if (j > columns - 2)
+      j = columns - 2;
+   double fa = a - i;
+   double fs = s - j;
+   if (fa > 1.0)
+      fa = 1.0;
+   if (fs > 1.0)
+      fs = 1.0;
+
+   const double * low = &grid[i * columns + j];
+   const double * high = low + columns;
+   double atLow = low[0] + (low[1] - low[0]) * fs;
+   double atHigh = high[0] + (high[1] - high[0]) * fs;
+   return atLow + (atHigh - atLow) * fa;
+}
+
+
+/**************************************
+DRAG TABLE : ERROR AGAINST THE CHAIN
+***************************************/
+dragTableError DragTable::measureError(int samples) const
+{
+   dragTableError error = {};
+   // a fixed sequence so the report is the same every run
+   unsigned int seed = 12345;
+   double maxAltitude = (rows - 1) * altitudeStep;
+   double maxSpeed = (columns - 1) * speedStep;
+   for (int k = 0; k < samples; k++)
+   {
+      seed = seed * 1664525u + 1013904223u;
+      double altitude = maxAltitude * (seed >> 8) / 16777216.0;
+      seed = seed * 1664525u + 1013904223u;
+      double speed = maxSpeed * (seed >> 8) / 16777216.0;
+
+      double exact = dragPerSpeedSquaredChain(altitude, speed);
+      double relative = exact > 0.0 ? fabs(dragPerSpeedSquared(altitude, speed) - exact) / exact : 0.0;
+      error.mean += relative;
+      if (relative > error.maximum)
+      {
+         error.maximum = relative;
+         error.worstAltitude = altitude;
+         error.worstSpeed = speed;
+      }
+   }
+   if (samples > 0)
+      error.mean /= samples;
+   return error;
+}
+
+
+/**************************************
+THE DEFAULT TABLE FOR THIS THREAD'S MET DATA
+***************************************/
+const DragTable & defaultDragTable()
+{
+   // Each thread holds on to the table it used last and only goes to the
+   // shared one, under the lock, once its met data no longer matches. A
+   // table is never changed after it is built, so a thread still flying
+   // with an old one is not disturbed by the new one
+   static mutex lock;
+   static shared_ptr <const DragTable> latest;
+   static thread_local shared_ptr <const DragTable> mine;
+
+   if (!mine || !mine->isBuiltFor(getMetData()))
+   {
+      lock_guard <mutex> guard(lock);
+      if (!latest || !latest->isBuiltFor(getMetData()))
+         latest = make_shared <const DragTable>();
+      mine = latest;
+   }
+   return *mine;
+}
+
+
+/**************************************
+ACCELERATION WITH DRAG FROM THE TABLE
+***************************************/
+void computeAccelerationFromTable(const DragTable & table, const shellState & shell, double & ddx, double & ddy)
+{
+   accelerationFromTable(table, shell.y, shell.dx, shell.dy, ddx, ddy);
+}
+
+
+/**************************************
+ADVANCE A SHELL WITH A TABLE
+***************************************/
+void stepShellWithTable(const DragTable & table, shellState & shell, double timeInterval)
+{
+   advanceWithTable(table, shell.x, shell.y, shell.dx, shell.dy, shell.hang, timeInterval);
+}
+
+
+/**************************************
+ADVANCE A SHELL WITH THE DEFAULT TABLE
+***************************************/
+void stepShellTable(shellState & shell, double timeInterval)
+{
+   stepShellWithTable(defaultDragTable(), shell, timeInterval);
+}
@@ -0,0 +1,123 @@
+/***********************************************************************
+ * Header File:
+ *    Drag Table : Drag acceleration over altitude and speed in one lookup
+ * Author:
+ *    Marco Varela
+ * Summary:
+ *    Every step normally goes density, speed of sound, Mach, drag
+ *    coefficient, force and acceleration. For a given shell all of that
+ *    divided by v squared only depends on (altitude, speed), so it is
+ *    precomputed on a grid and read back with one bilinear lookup. The
+ *    grid is rebuilt when the shell or the met data changes
+ ************************************************************************/
+
+#pragma once
+#include "simulation.h"
+
+
+/*********************************************
+ * STRUCTURE - DRAG TABLE ERROR
+ * How far the table is from the full chain, relative to the chain
+ *********************************************/
+struct dragTableError
+{
+   double maximum;
+   double mean;
+   double worstAltitude;
+   double worstSpeed;
+};
+
+
+/*****************************************************
+ * DRAG TABLE
+ *****************************************************/
+class DragTable
+{
+public:
+   DragTable(double mass = 46.7, double area = 0.018842,
+             double altitudeMax = 40000.0, double altitudeStep = 100.0,
+             double speedMax = 1500.0, double speedStep = 2.0);
+
+   // Drag acceleration divided by speed squared, so acceleration = value * v * v
+   double dragPerSpeedSquared(double altitude, double speed) const;
+
+   // The same number the long way, for checking the table
+   double dragPerSpeedSquaredChain(double altitude, double speed) const;
+
+   // A different shell means a different table
+   void setShell(double mass, double area);
+
+   // True if the grid was made with these met values
+   bool isBuiltFor(const metData & met) const
+   {
+      return met.densityFactor == builtWith.densityFactor && met.speedOfSoundFactor == builtWith.speedOfSoundFactor;
+   }
+
+   // Rebuild if the met data differs from what the grid was made with. For a
+   // table of your own; the default table takes care of itself
+   void rebuildIfStale();
+
+   // Compare against the chain at samples points spread over the grid
+   dragTableError measureError(int samples) const;
+
+   int getBuilds() const { return builds; }
+
+private:
+   double mass;
+   double area;
+   double altitudeStep;
+   double speedStep;
+   int rows;             // altitudes
+   int columns;          // speeds
+   vector <double> grid; // row major, altitude then speed
+   metData builtWith;    // met data the grid was made with
+   int builds;
+
+   void build();
+};
+
+
+// The table the table stepper uses, built for the met data this thread is
+// using. The first call after the met data changes builds a new one
+const DragTable & defaultDragTable();
+
+
+// Acceleration with drag from a table on plain numbers. ddy includes gravity.
+// Drag is k v^2 against the direction of travel, so each component is
+// k v times that component of the velocity
+inline void accelerationFromTable(const DragTable & table, double y, double dx, double dy,
+                                  double & ddx, double & ddy)
+{
+   double velocity = sqrt(dx * dx + dy * dy);
+   double dragPerSpeed = table.dragPerSpeedSquared(y, velocity) * velocity;
+   ddx = -dragPerSpeed * dx;
+   ddy = gravityFromAltitude(y) - dragPerSpeed * dy;
+}
+
+
+// One stepShell with drag from a table on plain numbers, so a loop over
+// lanes kept as separate arrays runs exactly the same arithmetic
+inline void advanceWithTable(const DragTable & table, double & x, double & y, double & dx, double & dy,
+                             double & hang, double timeInterval)
+{
+   double ddx;
+   double ddy;
+   accelerationFromTable(table, y, dx, dy, ddx, ddy);
+   dy = computeVelocity(dy, ddy, timeInterval);
+   dx = computeVelocity(dx, ddx, timeInterval);
+   x = calculateDisplacement(x, dx, ddx, timeInterval);
+   y = calculateDisplacement(y, dy, ddy, timeInterval);
+   hang += timeInterval;
+}
+
+
+// Acceleration on a shell with drag from a table. ddy includes gravity
+void computeAccelerationFromTable(const DragTable & table, const shellState & shell, double & ddx, double & ddy);
+
+
+// stepShell with the drag from a given table. Only reads the table
+void stepShellWithTable(const DragTable & table, shellState & shell, double timeInterval);
+
+
+// stepShell with the drag from the default table. Only reads the table
+void stepShellTable(shellState & shell, double timeInterval);
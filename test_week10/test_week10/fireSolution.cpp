@@ -0,0 +1,282 @@
+/******************************
+* Authors:
+* Marco Varela
+* Purpose:
+* Solving for the angle and re-solving when the met data changes
+*******************************/
+
+#include "fireSolution.h"
+using namespace std;
+
+// give up on a target after this many secant steps
+const int MAX_SECANT_STEPS = 30;
+// give up on a bisection after this many halvings, far past double precision on any angle range
+const int MAX_BISECT_STEPS = 60;
+// how far apart the first two secant guesses are when we know nothing (degrees)
+const double FIRST_ANGLE_STEP = 1.0;
+// how much the met data is nudged to measure the sensitivities
+const double MET_NUDGE = 0.01;
+
+
+/**************************************
+KEEP THE ANGLE BETWEEN STRAIGHT UP AND FLAT
+***************************************/
+static double clampAngle(double angle)
+{
+   if (angle < 0.5)
+      return 0.5;
+   if (angle > 89.5)
+      return 89.5;
+   return angle;
+}
+
+
+/**************************************
+SOLVE FOR THE ANGLE
+***************************************/
+fireSolution solveFireSolution(double targetDistance, double muzzleVelocity,
+                               double angleGuess, double slopeGuess, double tolerance, int & shots)
+{
+   fireSolution solution = {};
+   solution.targetDistance = targetDistance;
+   solution.muzzleVelocity = muzzleVelocity;
+   solution.solvedWith = getMetData();
+
+   double angle0 = clampAngle(angleGuess);
+   trajectorySummary summary0 = simulateShot(angle0, muzzleVelocity);
+   double miss0 = summary0.distance - targetDistance;
+   shots++;
+
+   double slope = slopeGuess;
+   double angle1 = angle0;
+   trajectorySummary summary1 = summary0;
+   double miss1 = miss0;
+
+   for (int i = 0; i < MAX_SECANT_STEPS && fabs(miss1) > tolerance; i++)
+   {
+      // the first step uses the slope we were handed, if any
+      if (i == 0)
+         angle1 = clampAngle(slope != 0.0 ? angle0 - miss0 / slope : angle0 + FIRST_ANGLE_STEP);
+      else
+      {
+         if (angle1 == angle0 || miss1 == miss0)
+            break;
+         slope = (miss1 - miss0) / (angle1 - angle0);
+         angle0 = angle1;
+         miss0 = miss1;
+         angle1 = clampAngle(angle1 - miss1 / slope);
+      }
+      summary1 = simulateShot(angle1, muzzleVelocity);
+      miss1 = summary1.distance - targetDistance;
+      shots++;
+   }
+
+   if (angle1 != angle0 && miss1 != miss0)
+      slope = (miss1 - miss0) / (angle1 - angle0);
+
+   solution.angle = angle1;
+   solution.summary = summary1;
+   solution.solved = fabs(miss1) <= tolerance;
+   solution.distancePerAngle = slope;
+   return solution;
+}
+
+
+/**************************************
+WHICH SIDE OF THE TARGET A SHOT LANDS ON
+* +1 long, -1 short, 0 close enough
+***************************************/
+static int landingSide(double targetDistance, double muzzleVelocity, double angle,
+                       const stopRules & rules, double tolerance,
+                       int & shots, long & steps, trajectorySummary & summary)
+{
+   flightResult flight = simulateShotUntil(angle, muzzleVelocity, rules);
+   shots++;
+   steps += flight.steps;
+   summary = flight.summary;
+
+   if (flight.reason == STOP_DISTANCE)
+      return 1;
+   double miss = flight.summary.distance - targetDistance;
+   if (fabs(miss) <= tolerance)
+      return 0;
+   return miss > 0.0 ? 1 : -1;
+}
+
+
+/**************************************
+SOLVE FOR THE ANGLE BY BISECTION
+***************************************/
+fireSolution solveFireSolutionBisect(double targetDistance, double muzzleVelocity,
+                                     double angleLow, double angleHigh, double tolerance,
+                                     int & shots, long & steps, bool earlyExit)
+{
+   fireSolution solution = {};
+   solution.targetDistance = targetDistance;
+   solution.muzzleVelocity = muzzleVelocity;
+   solution.solvedWith = getMetData();
+
+   stopRules rules = noStopRules();
+   if (earlyExit)
+      rules.maxDistance = targetDistance + tolerance;
+
+   trajectorySummary summary;
+   int sideLow = landingSide(targetDistance, muzzleVelocity, angleLow, rules, tolerance, shots, steps, summary);
+   solution.angle = angleLow;
+   solution.summary = summary;
+   if (sideLow == 0)
+   {
+      solution.solved = true;
+      return solution;
+   }
+   int sideHigh = landingSide(targetDistance, muzzleVelocity, angleHigh, rules, tolerance, shots, steps, summary);
+   solution.angle = angleHigh;
+   solution.summary = summary;
+   if (sideHigh == 0 || sideHigh == sideLow)
+   {
+      // either a hit, or both on the same side and nothing to bisect
+      solution.solved = (sideHigh == 0);
+      return solution;
+   }
+
+   for (int i = 0; i < MAX_BISECT_STEPS; i++)
+   {
+      double middle = (angleLow + angleHigh) * 0.5;
+      int side = landingSide(targetDistance, muzzleVelocity, middle, rules, tolerance, shots, steps, summary);
+      solution.angle = middle;
+      solution.summary = summary;
+      if (side == 0)
+      {
+         solution.solved = true;
+         break;
+      }
+      if (side == sideLow)
+         angleLow = middle;
+      else
+         angleHigh = middle;
+   }
+   return solution;
+}
+
+
+/**************************************
+HOW THE DISTANCE MOVES WITH THE MET DATA
+***************************************/
+void measureMetSensitivity(fireSolution & solution, int & shots)
+{
+   // nudged on this thread only, so other threads keep flying the real met data
+   const metData saved = getMetData();
+   metData nudged = saved;
+   nudged.densityFactor += MET_NUDGE;
+   const metData * outer = useMetData(&nudged);
+   double denser = simulateShot(solution.angle, solution.muzzleVelocity).distance;
+
+   nudged = saved;
+   nudged.speedOfSoundFactor += MET_NUDGE;
+   double faster = simulateShot(solution.angle, solution.muzzleVelocity).distance;
+
+   useMetData(outer);
+   shots += 2;
+
+   solution.distancePerDensity = (denser - solution.summary.distance) / MET_NUDGE;
+   solution.distancePerSpeedOfSound = (faster - solution.summary.distance) / MET_NUDGE;
+}
+
+
+/**************************************
+PREDICTED MOVE OF THE IMPACT POINT
+***************************************/
+double predictedShift(const fireSolution & solution, const metData & met)
+{
+   return solution.distancePerDensity * (met.densityFactor - solution.solvedWith.densityFactor) +
+      solution.distancePerSpeedOfSound * (met.speedOfSoundFactor - solution.solvedWith.speedOfSoundFactor);
+}
+
+
+/**************************************
+FIRE SOLUTION STORE : CONSTRUCTOR
+***************************************/
+FireSolutionStore::FireSolutionStore(double tolerance, double angleGuess) :
+   tolerance(tolerance), angleGuess(angleGuess), skipped(0), resolved(0), shots(0)
+{
+}
+
+
+/**************************************
+FIRE SOLUTION STORE : ADD A TARGET
+***************************************/
+int FireSolutionStore::add(double targetDistance, double muzzleVelocity)
+{
+   skipped = 0;
+   resolved = 0;
+   shots = 0;
+   fireSolution solution = solveFireSolution(targetDistance, muzzleVelocity, angleGuess, 0.0, tolerance, shots);
+   measureMetSensitivity(solution, shots);
+   solutions.push_back(solution);
+   resolved++;
+   return (int)solutions.size() - 1;
+}
+
+
+/**************************************
+FIRE SOLUTION STORE : INCREMENTAL MET UPDATE
+***************************************/
+void FireSolutionStore::updateMet(const metData & met)
+{
+   setMetData(met);
+   skipped = 0;
+   resolved = 0;
+   shots = 0;
+
+   for (size_t i = 0; i < solutions.size(); i++)
+   {
+      fireSolution & old = solutions[i];
+
+      // Too small to matter: the old angle still lands within tolerance.
+      // solvedWith stays put so small changes add up instead of slipping by
+      double shift = predictedShift(old, met);
+      if (old.solved && fabs(old.summary.distance + shift - old.targetDistance) <= tolerance)
+      {
+         skipped++;
+         continue;
+      }
+
+      // Start where the sensitivities say the answer has moved to, and
+      // keep the met sensitivities since they change slowly
+      double guess = old.angle;
+      if (old.distancePerAngle != 0.0)
+         guess -= shift / old.distancePerAngle;
+      fireSolution fresh = solveFireSolution(old.targetDistance, old.muzzleVelocity,
+                                             guess, old.distancePerAngle, tolerance, shots);
+      fresh.distancePerDensity = old.distancePerDensity;
+      fresh.distancePerSpeedOfSound = old.distancePerSpeedOfSound;
+      if (!fresh.solved)
+      {
+         // the warm start wandered off, fall back to a cold one
+         fresh = solveFireSolution(old.targetDistance, old.muzzleVelocity, angleGuess, 0.0, tolerance, shots);
+         measureMetSensitivity(fresh, shots);
+      }
+      old = fresh;
+      resolved++;
+   }
+}
+
+
+/**************************************
+FIRE SOLUTION STORE : FULL RECOMPUTE
+***************************************/
+void FireSolutionStore::recomputeAll(const metData & met)
+{
+   setMetData(met);
+   skipped = 0;
+   resolved = 0;
+   shots = 0;
+
+   for (size_t i = 0; i < solutions.size(); i++)
+   {
+      fireSolution & old = solutions[i];
+      old = solveFireSolution(old.targetDistance, old.muzzleVelocity, angleGuess, 0.0, tolerance, shots);
+      measureMetSensitivity(old, shots);
+      resolved++;
+   }
+}
@@ -0,0 +1,94 @@
+/***********************************************************************
+ * Header File:
+ *    Fire Solution : The angle that puts a shell on a target
+ * Author:
+ *    Marco Varela
+ * Summary:
+ *    Solves for the angle with the secant method on simulateShot, and
+ *    keeps what it learned (the trajectory, how distance moves with
+ *    angle and with the met data) so a new met message can be folded
+ *    in by correcting the old answers instead of solving from scratch
+ ************************************************************************/
+
+#pragma once
+#include "simulation.h"
+
+
+/*********************************************
+ * STRUCTURE - FIRE SOLUTION
+ * An answer and its sensitivities
+ *********************************************/
+struct fireSolution
+{
+   double targetDistance;
+   double muzzleVelocity;
+   double angle;                   // degrees from vertical
+   trajectorySummary summary;
+   bool solved;
+
+   double distancePerAngle;        // m per degree
+   double distancePerDensity;      // m per unit of densityFactor
+   double distancePerSpeedOfSound; // m per unit of speedOfSoundFactor
+   metData solvedWith;             // the met data the answer is good for
+};
+
+
+// Solve from a first guess. Low angle fire sits above the angle of greatest
+// range, so the default guess is there. slopeGuess is m per degree, 0 if unknown.
+// shots counts the simulations spent
+fireSolution solveFireSolution(double targetDistance, double muzzleVelocity,
+                               double angleGuess, double slopeGuess, double tolerance, int & shots);
+
+
+// Solve by bisection between two angles whose shots land on either side
+// of the target. Only the side matters, so with earlyExit a shot that
+// passes the target is dropped as soon as it does. steps counts the
+// simulation steps spent
+fireSolution solveFireSolutionBisect(double targetDistance, double muzzleVelocity,
+                                     double angleLow, double angleHigh, double tolerance,
+                                     int & shots, long & steps, bool earlyExit = true);
+
+
+// Measure how the distance moves with the met data, two more simulations
+void measureMetSensitivity(fireSolution & solution, int & shots);
+
+
+// How far the impact should move if the met data became met
+double predictedShift(const fireSolution & solution, const metData & met);
+
+
+/*****************************************************
+ * FIRE SOLUTION STORE
+ * Every target we have a solution for. A met update re-solves only
+ * the ones the sensitivities say have moved, starting from the old answer
+ *****************************************************/
+class FireSolutionStore
+{
+public:
+   FireSolutionStore(double tolerance = 1.0, double angleGuess = 70.0);
+
+   // Solve a new target under the current met data. Returns its index
+   int add(double targetDistance, double muzzleVelocity);
+
+   // Make met current and bring the solutions up to date incrementally
+   void updateMet(const metData & met);
+
+   // Make met current and solve every target from scratch
+   void recomputeAll(const metData & met);
+
+   const fireSolution & get(int index) const { return solutions[index]; }
+   int size() const { return (int)solutions.size(); }
+
+   // what the last add, update or recompute did
+   int getSkipped() const { return skipped; }
+   int getResolved() const { return resolved; }
+   int getShots() const { return shots; }
+
+private:
+   double tolerance;       // m, the miss we are willing to live with
+   double angleGuess;
+   vector <fireSolution> solutions;
+   int skipped;
+   int resolved;
+   int shots;
+};
@@ -96,13 +96,71 @@ const vector<tables> speedsOfSound =
    {40000,	324}
 };
 
+// The tables above, and the set each thread reads. A worker can point
+// its thread at a copy that lives in memory local to its NUMA node
+static const lookupTables standard = { gravities, densities, dragCoefecients, speedsOfSound };
+static thread_local const lookupTables * threadTables = &standard;
+
+
+/**************************************
+FUNCTION TO GET THE SHARED TABLES
+***************************************/
+const lookupTables & standardTables()
+{
+   return standard;
+}
+
+
+/**************************************
+FUNCTION TO PICK THE TABLES THIS THREAD READS
+***************************************/
+void useLookupTables(const lookupTables * replica)
+{
+   threadTables = (replica == NULL) ? &standard : replica;
+}
+
+
+// Standard day until a met message says otherwise. A thread can point
+// itself at its own met data instead, NULL means it reads the shared one
+static metData currentMet = { 1.0, 1.0 };
+static thread_local const metData * threadMet = NULL;
+
+
+/**************************************
+FUNCTION TO SET THE MET DATA
+***************************************/
+void setMetData(const metData & met)
+{
+   currentMet = met;
+}
+
+
+/**************************************
+FUNCTION TO PICK THE MET DATA THIS THREAD READS
+***************************************/
+const metData * useMetData(const metData * met)
+{
+   const metData * replaced = threadMet;
+   threadMet = met;
+   return replaced;
+}
+
+
+/**************************************
+FUNCTION TO GET THE MET DATA
+***************************************/
+const metData & getMetData()
+{
+   return (threadMet == NULL) ? currentMet : *threadMet;
+}
+
 
 /**************************************
 FUNCTION TO GET GRAVITY FROM ALTITUDE
 ***************************************/
 double gravityFromAltitude(double altitude)
 {
-   return linearInterpolation(gravities, altitude) * -1;
+   return linearInterpolation(threadTables->gravities, altitude) * -1;
 }
 
 
@@ -111,7 +169,7 @@ FUNCTION TO GET DRAG COEFFICIENT FROM MACH
 ***************************************/
 double dragFromMach(double mach)
 {
-   return linearInterpolation(dragCoefecients, mach);
+   return linearInterpolation(threadTables->dragCoefecients, mach);
 }
 
 
@@ -121,7 +179,7 @@ FUNCTION TO GET DENSITY FROM ALTITUDE
 ***************************************/
 double densityFromAltitude(double altitude)
 {
-   return linearInterpolation(densities, altitude);
+   return linearInterpolation(threadTables->densities, altitude) * getMetData().densityFactor;
 }
 
 
@@ -131,7 +189,7 @@ FUNCTION TO GET SPEED OF SOUND FROM ALTITUDE
 ***************************************/
 double speedOfSoundFromAltitude(double altitude)
 {
-   return linearInterpolation(speedsOfSound, altitude);
+   return linearInterpolation(threadTables->speedsOfSound, altitude) * getMetData().speedOfSoundFactor;
 }
 
 
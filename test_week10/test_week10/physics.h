@@ -28,6 +28,51 @@ struct tables
 };
 
 
+/*********************************************
+ * ESTRUCTURE - LOOKUP TABLES
+ * Every table the lookups read, so a thread can be given its own copy
+ *********************************************/
+struct lookupTables
+{
+   vector <tables> gravities;
+   vector <tables> densities;
+   vector <tables> dragCoefecients;
+   vector <tables> speedsOfSound;
+};
+
+
+// Function to get the tables every thread reads unless told otherwise
+const lookupTables & standardTables();
+
+
+// Function to make this thread read a copy of the tables. NULL goes back to the shared ones
+void useLookupTables(const lookupTables * replica);
+
+
+/*********************************************
+ * ESTRUCTURE - MET DATA
+ * Meteorological corrections on top of the standard tables, as the
+ * ratio of measured to standard. 1.0 is a standard day
+ *********************************************/
+struct metData
+{
+   double densityFactor;
+   double speedOfSoundFactor;
+};
+
+
+// Function to set the met data used by the lookups. Set it between runs, not during one
+void setMetData(const metData & met);
+
+
+// Function to make this thread read its own met data, which must outlive its use.
+// NULL goes back to the shared one. Returns the one it replaces so it can be put back
+const metData * useMetData(const metData * met);
+
+
+// Function to get the met data this thread is using
+const metData & getMetData();
+
 
 // Function to get a value from a table, to be used later on calculating linear interpolation
 double linearInterpolation(const vector <tables>& table, double key);
@@ -0,0 +1,206 @@
+/******************************
+* Authors:
+* Marco Varela
+* Purpose:
+* Resumable shell flights and the per frame scheduler
+*******************************/
+
+#include "scheduler.h"
+#include <chrono>
+using namespace std;
+
+// how many steps between looks at the wall clock
+const int STEPS_PER_CLOCK_CHECK = 32;
+
+
+/**************************************
+SHELL FLIGHT : CONSTRUCTOR
+***************************************/
+ShellFlight::ShellFlight(double angle, double muzzleVelocity, double timeInterval) :
+   timeInterval(timeInterval), apex(0.0), landed(false), summary()
+{
+   current = launchShell(angle, muzzleVelocity);
+   previous = current;
+}
+
+
+/**************************************
+SHELL FLIGHT : ADVANCE ONE STEP
+***************************************/
+bool ShellFlight::step()
+{
+   if (landed)
+      return false;
+
+   previous = current;
+   stepShell(current, timeInterval);
+   if (current.y > apex)
+      apex = current.y;
+
+   if (current.y < 0)
+   {
+      landed = true;
+      summary = landShell(previous, current, apex);
+   }
+   return !landed;
+}
+
+
+/**************************************
+SHELL FLIGHT : INTERPOLATE BETWEEN STEPS
+***************************************/
+shellState ShellFlight::interpolate(double alpha) const
+{
+   if (alpha < 0.0)
+      alpha = 0.0;
+   if (alpha > 1.0)
+      alpha = 1.0;
+
+   shellState shell;
+   shell.x = calculateLinearInterpolation(0.0, previous.x, 1.0, current.x, alpha);
+   shell.y = calculateLinearInterpolation(0.0, previous.y, 1.0, current.y, alpha);
+   shell.dx = calculateLinearInterpolation(0.0, previous.dx, 1.0, current.dx, alpha);
+   shell.dy = calculateLinearInterpolation(0.0, previous.dy, 1.0, current.dy, alpha);
+   shell.hang = calculateLinearInterpolation(0.0, previous.hang, 1.0, current.hang, alpha);
+   return shell;
+}
+
+
+/**************************************
+FLIGHT SCHEDULER : CONSTRUCTOR
+***************************************/
+FlightScheduler::FlightScheduler(double timeInterval) :
+   timeInterval(timeInterval), clock(0.0), nextId(0), resumeId(0)
+{
+}
+
+
+/**************************************
+FLIGHT SCHEDULER : LAUNCH A SHELL
+***************************************/
+int FlightScheduler::launch(double angle, double muzzleVelocity)
+{
+   scheduledFlight scheduled = { ShellFlight(angle, muzzleVelocity, timeInterval), clock };
+   flights.insert(make_pair(nextId, scheduled));
+   return nextId++;
+}
+
+
+/**************************************
+FLIGHT SCHEDULER : ADVANCE ONE FRAME
+***************************************/
+int FlightScheduler::advance(double frameSeconds, double budgetSeconds)
+{
+   clock += frameSeconds;
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+   // A shell is behind when it is more than a sliver of a step short of the
+   // game clock. Step every shell that is behind once per pass so a tight
+   // budget leaves all of them a little late instead of some of them frozen.
+   // A pass starts where the last frame ran out, so the same shells do not
+   // always get the extra step
+   const double sliver = timeInterval * 1e-6;
+   int steps = 0;
+   bool behind = true;
+   while (behind)
+   {
+      behind = false;
+      map <int, scheduledFlight> ::iterator it = flights.lower_bound(resumeId);
+      for (size_t visited = 0; visited < flights.size(); visited++, ++it)
+      {
+         if (it == flights.end())
+            it = flights.begin();
+         ShellFlight & flight = it->second.flight;
+         if (flight.hasLanded() || flight.getCurrent().hang + sliver >= clock - it->second.launchTime)
+            continue;
+
+         flight.step();
+         behind = true;
+         steps++;
+
+         if (steps % STEPS_PER_CLOCK_CHECK == 0)
+         {
+            chrono::duration <double> elapsed = chrono::steady_clock::now() - start;
+            if (elapsed.count() >= budgetSeconds)
+            {
+               ++it;
+               resumeId = it == flights.end() ? 0 : it->first;
+               return steps;
+            }
+         }
+      }
+   }
+   return steps;
+}
+
+
+/**************************************
+FLIGHT SCHEDULER : WHERE TO DRAW A SHELL
+***************************************/
+shellState FlightScheduler::renderPosition(int id) const
+{
+   const scheduledFlight & scheduled = find(id);
+   const shellState & previous = scheduled.flight.getPrevious();
+   const shellState & current = scheduled.flight.getCurrent();
+
+   double span = current.hang - previous.hang;
+   if (span <= 0.0)
+      return current;
+   double alpha = (clock - scheduled.launchTime - previous.hang) / span;
+
+   // the last step of a landed shell ends below ground, so stop at the impact point
+   if (scheduled.flight.hasLanded())
+   {
+      double impact = previous.y / (previous.y - current.y);
+      if (alpha >= impact)
+      {
+         const trajectorySummary & summary = scheduled.flight.getSummary();
+         shellState shell = scheduled.flight.interpolate(impact);
+         shell.x = summary.distance;
+         shell.y = 0.0;
+         shell.hang = summary.hangTime;
+         return shell;
+      }
+   }
+   return scheduled.flight.interpolate(alpha);
+}
+
+
+/**************************************
+FLIGHT SCHEDULER : HAS A SHELL LANDED
+***************************************/
+bool FlightScheduler::hasLanded(int id) const
+{
+   return find(id).flight.hasLanded();
+}
+
+
+/**************************************
+FLIGHT SCHEDULER : SUMMARY OF A LANDED SHELL
+***************************************/
+const trajectorySummary & FlightScheduler::getSummary(int id) const
+{
+   return find(id).flight.getSummary();
+}
+
+
+/**************************************
+FLIGHT SCHEDULER : FORGET A SHELL
+***************************************/
+void FlightScheduler::remove(int id)
+{
+   flights.erase(id);
+}
+
+
+/**************************************
+FLIGHT SCHEDULER : SHELLS STILL IN THE AIR
+***************************************/
+int FlightScheduler::inFlight() const
+{
+   int count = 0;
+   for (map <int, scheduledFlight> ::const_iterator it = flights.begin(); it != flights.end(); ++it)
+      if (!it->second.flight.hasLanded())
+         count++;
+   return count;
+}
@@ -0,0 +1,96 @@
+/***********************************************************************
+ * Header File:
+ *    Scheduler : Advances many shells a little bit every frame
+ * Author:
+ *    Marco Varela
+ * Summary:
+ *    ShellFlight is the while (y >= 0) loop turned inside out so it
+ *    can stop after any step and pick up later. FlightScheduler keeps
+ *    a fixed physics time interval, interleaves the shells one step
+ *    at a time until they catch up with the game clock or the frame
+ *    budget runs out, and hands back positions interpolated between
+ *    physics ticks for drawing
+ ************************************************************************/
+
+#pragma once
+#include <map>
+#include "simulation.h"
+
+
+/*****************************************************
+ * SHELL FLIGHT
+ * One shell that can be advanced one step at a time
+ *****************************************************/
+class ShellFlight
+{
+public:
+   ShellFlight(double angle, double muzzleVelocity, double timeInterval = 0.01);
+
+   // Advance one time interval. Returns false once the shell has landed
+   bool step();
+
+   bool hasLanded() const { return landed; }
+   const shellState & getCurrent() const { return current; }
+   const shellState & getPrevious() const { return previous; }
+
+   // Position between the previous and current step, alpha in [0, 1]
+   shellState interpolate(double alpha) const;
+
+   // Only meaningful once the shell has landed
+   const trajectorySummary & getSummary() const { return summary; }
+
+private:
+   shellState current;
+   shellState previous;
+   double timeInterval;
+   double apex;
+   bool landed;
+   trajectorySummary summary;
+};
+
+
+/*****************************************************
+ * FLIGHT SCHEDULER
+ * Owns the shells in the air and spreads their steps over frames
+ *****************************************************/
+class FlightScheduler
+{
+public:
+   FlightScheduler(double timeInterval = 0.01);
+
+   // Put a shell in the air at the current game time. Returns its id
+   int launch(double angle, double muzzleVelocity);
+
+   // Move the game clock forward by frameSeconds and step shells until they
+   // have caught up or budgetSeconds of wall time has gone by. Shells that
+   // did not catch up continue on the next frame. Returns the steps taken
+   int advance(double frameSeconds, double budgetSeconds);
+
+   // Where to draw a shell at the current game time. A landed shell stays at its impact point
+   shellState renderPosition(int id) const;
+
+   bool contains(int id) const { return flights.count(id) != 0; }
+   bool hasLanded(int id) const;
+   const trajectorySummary & getSummary(int id) const;
+   void remove(int id);
+
+   int inFlight() const;
+   int size() const { return (int)flights.size(); }
+   double getClock() const { return clock; }
+
+private:
+   double timeInterval;
+   double clock;          // game time (s)
+   int nextId;
+   int resumeId;          // the flight the next pass starts at
+
+   // a flight and the game time it was launched at
+   struct scheduledFlight
+   {
+      ShellFlight flight;
+      double launchTime;
+   };
+   map <int, scheduledFlight> flights;
+
+   const scheduledFlight & find(int id) const { return flights.at(id); }
+};
@@ -0,0 +1,209 @@
+/******************************
+* Authors:
+* Marco Varela
+* Purpose:
+* The fixed capacity shell pool and its target grid
+*******************************/
+
+#include "shellPool.h"
+using namespace std;
+
+
+/**************************************
+SHELL POOL : CONSTRUCTOR
+***************************************/
+ShellPool::ShellPool(int capacity, double cellSize, double timeInterval) :
+   cellSize(cellSize), timeInterval(timeInterval),
+   shells(capacity), generations(capacity, 0), alive(capacity, false),
+   live(0), stamp(0), checks(0)
+{
+   // hand out the low slots first
+   freeSlots.reserve(capacity);
+   for (int i = capacity - 1; i >= 0; i--)
+      freeSlots.push_back(i);
+   events.reserve(capacity);
+}
+
+
+/**************************************
+SHELL POOL : LAUNCH A SHELL
+***************************************/
+shellHandle ShellPool::launch(double angle, double muzzleVelocity)
+{
+   shellHandle handle = { -1, 0 };
+   if (freeSlots.empty())
+      return handle;
+
+   handle.index = freeSlots.back();
+   handle.generation = generations[handle.index];
+   freeSlots.pop_back();
+
+   shells[handle.index] = launchShell(angle, muzzleVelocity);
+   alive[handle.index] = true;
+   live++;
+   return handle;
+}
+
+
+/**************************************
+SHELL POOL : IS THE HANDLE STILL GOOD
+***************************************/
+bool ShellPool::isAlive(shellHandle handle) const
+{
+   return handle.index >= 0 && handle.index < (int)shells.size() &&
+      alive[handle.index] && generations[handle.index] == handle.generation;
+}
+
+
+/**************************************
+SHELL POOL : GIVE A SLOT BACK
+***************************************/
+void ShellPool::release(shellHandle handle)
+{
+   if (!isAlive(handle))
+      return;
+   alive[handle.index] = false;
+   generations[handle.index]++;
+   freeSlots.push_back(handle.index);
+   live--;
+}
+
+
+/**************************************
+SHELL POOL : KEY FOR A GRID CELL
+***************************************/
+unsigned long long ShellPool::cellKey(int column, int row) const
+{
+   // through unsigned, since shifting a negative column is undefined
+   return ((unsigned long long)(unsigned int)column << 32) | (unsigned int)row;
+}
+
+
+/**************************************
+SHELL POOL : ADD A TARGET TO THE GRID
+***************************************/
+int ShellPool::addTarget(double x, double y, double radius)
+{
+   target aim = { x, y, radius };
+   int index = (int)targets.size();
+   targets.push_back(aim);
+   stamps.push_back(-1);
+
+   // the target goes in every cell its bounding box touches
+   for (int column = cellOf(x - radius); column <= cellOf(x + radius); column++)
+      for (int row = cellOf(y - radius); row <= cellOf(y + radius); row++)
+         grid[cellKey(column, row)].push_back(index);
+   return index;
+}
+
+
+/**************************************
+SHELL POOL : REMOVE ALL TARGETS
+***************************************/
+void ShellPool::clearTargets()
+{
+   targets.clear();
+   stamps.clear();
+   grid.clear();
+}
+
+
+/**************************************
+SHELL POOL : DOES A MOVE CROSS A TARGET
+* Tests the whole segment so a fast shell cannot step over a
+* small target. fraction is how far along the segment it enters
+***************************************/
+bool ShellPool::segmentHitsTarget(const shellState & from, const shellState & to,
+                                  const target & aim, double & fraction) const
+{
+   double dx = to.x - from.x;
+   double dy = to.y - from.y;
+   double fx = from.x - aim.x;
+   double fy = from.y - aim.y;
+   double a = dx * dx + dy * dy;
+   double b = 2.0 * (fx * dx + fy * dy);
+   double c = fx * fx + fy * fy - aim.radius * aim.radius;
+
+   // already inside
+   if (c <= 0.0)
+   {
+      fraction = 0.0;
+      return true;
+   }
+   double discriminant = b * b - 4.0 * a * c;
+   if (a == 0.0 || discriminant < 0.0)
+      return false;
+
+   fraction = (-b - sqrt(discriminant)) / (2.0 * a);
+   return fraction >= 0.0 && fraction <= 1.0;
+}
+
+
+/**************************************
+SHELL POOL : STEP EVERY SHELL
+***************************************/
+const vector <hitEvent> & ShellPool::step()
+{
+   events.clear();
+   checks = 0;
+
+   for (int i = 0; i < (int)shells.size(); i++)
+   {
+      if (!alive[i])
+         continue;
+
+      shellState previous = shells[i];
+      shellState & shell = shells[i];
+      stepShell(shell, timeInterval);
+
+      // the ground, if we crossed it this step
+      hitEvent hit;
+      hit.shell.index = i;
+      hit.shell.generation = generations[i];
+      hit.target = -1;
+      double first = 2.0;
+      if (shell.y < 0)
+         first = previous.y / (previous.y - shell.y);
+
+      // broad phase: the cells under the box around this move
+      stamp++;
+      int columnLow = cellOf(fmin(previous.x, shell.x));
+      int columnHigh = cellOf(fmax(previous.x, shell.x));
+      int rowLow = cellOf(fmin(previous.y, shell.y));
+      int rowHigh = cellOf(fmax(previous.y, shell.y));
+      for (int column = columnLow; column <= columnHigh; column++)
+         for (int row = rowLow; row <= rowHigh; row++)
+         {
+            unordered_map <unsigned long long, vector <int> > ::const_iterator cell = grid.find(cellKey(column, row));
+            if (cell == grid.end())
+               continue;
+
+            // narrow phase, once per target even if it spans several cells
+            for (size_t k = 0; k < cell->second.size(); k++)
+            {
+               int index = cell->second[k];
+               if (stamps[index] == stamp)
+                  continue;
+               stamps[index] = stamp;
+               checks++;
+
+               double fraction;
+               if (segmentHitsTarget(previous, shell, targets[index], fraction) && fraction < first)
+               {
+                  first = fraction;
+                  hit.target = index;
+               }
+            }
+         }
+
+      if (first <= 1.0)
+      {
+         hit.x = calculateLinearInterpolation(0.0, previous.x, 1.0, shell.x, first);
+         hit.y = calculateLinearInterpolation(0.0, previous.y, 1.0, shell.y, first);
+         hit.hang = calculateLinearInterpolation(0.0, previous.hang, 1.0, shell.hang, first);
+         events.push_back(hit);
+         release(hit.shell);
+      }
+   }
+   return events;
+}
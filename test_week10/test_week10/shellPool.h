@@ -0,0 +1,108 @@
+/***********************************************************************
+ * Header File:
+ *    Shell Pool : Every shell in the air, in one fixed block of memory
+ * Author:
+ *    Marco Varela
+ * Summary:
+ *    The shells live in arrays sized once up front and are handed out
+ *    by handle, so launching and landing never allocate. Targets go in
+ *    a uniform grid and each step a shell is only tested against the
+ *    targets in the cells its last move passed through
+ ************************************************************************/
+
+#pragma once
+#include <unordered_map>
+#include "simulation.h"
+
+
+/*********************************************
+ * STRUCTURE - SHELL HANDLE
+ * Index into the pool plus the generation of that slot,
+ * so a handle to a shell that has landed goes stale
+ *********************************************/
+struct shellHandle
+{
+   int index;
+   int generation;
+};
+
+
+/*********************************************
+ * STRUCTURE - TARGET
+ * A circle in the plane of the trajectory
+ *********************************************/
+struct target
+{
+   double x;
+   double y;
+   double radius;
+};
+
+
+/*********************************************
+ * STRUCTURE - HIT EVENT
+ * A shell that hit a target or the ground this step
+ *********************************************/
+struct hitEvent
+{
+   shellHandle shell;
+   int target;        // index from addTarget, -1 for the ground
+   double x;
+   double y;
+   double hang;
+};
+
+
+/*****************************************************
+ * SHELL POOL
+ * Fixed capacity shells, a target grid and per step hit events
+ *****************************************************/
+class ShellPool
+{
+public:
+   ShellPool(int capacity, double cellSize = 500.0, double timeInterval = 0.01);
+
+   // Returns a handle with index -1 when the pool is full
+   shellHandle launch(double angle, double muzzleVelocity);
+   bool isAlive(shellHandle handle) const;
+   const shellState & get(shellHandle handle) const { return shells[handle.index]; }
+   void release(shellHandle handle);
+
+   // Targets are static between steps. Returns the target index
+   int addTarget(double x, double y, double radius);
+   void clearTargets();
+   int targetCount() const { return (int)targets.size(); }
+
+   // Step every shell, report what was hit and release those shells
+   const vector <hitEvent> & step();
+
+   int size() const { return live; }
+   int getCapacity() const { return (int)shells.size(); }
+   long getChecks() const { return checks; }   // narrow phase tests in the last step
+
+private:
+   double cellSize;
+   double timeInterval;
+
+   // the pool, all sized to the capacity
+   vector <shellState> shells;
+   vector <int> generations;
+   vector <bool> alive;
+   vector <int> freeSlots;
+   int live;
+
+   // targets and the cells they cover
+   vector <target> targets;
+   unordered_map <unsigned long long, vector <int> > grid;
+
+   // reused every step so stepping does not allocate
+   vector <hitEvent> events;
+   vector <long> stamps;     // per target, the last shell test it was in
+   long stamp;
+   long checks;
+
+   unsigned long long cellKey(int column, int row) const;
+   int cellOf(double position) const { return (int)floor(position / cellSize); }
+   bool segmentHitsTarget(const shellState & from, const shellState & to,
+                          const target & aim, double & fraction) const;
+};
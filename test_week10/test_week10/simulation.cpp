@@ -0,0 +1,182 @@
+/******************************
+* Authors:
+* Marco Varela
+* Purpose:
+* Flying a shell with the same step as test_hit_the_ground_8
+*******************************/
+
+#include "simulation.h"
+using namespace std;
+
+
+/**************************************
+LAUNCH A SHELL FROM THE MUZZLE
+***************************************/
+shellState launchShell(double angle, double muzzleVelocity)
+{
+   Angle launchAngle = Angle(angle);
+   shellState shell;
+   shell.x = 0.0;
+   shell.y = 0.0;
+   shell.dx = computeHorizontalComponent(launchAngle, muzzleVelocity);
+   shell.dy = computeVerticalComponent(launchAngle, muzzleVelocity);
+   shell.hang = 0.0;
+   return shell;
+}
+
+
+/**************************************
+ACCELERATION FROM GRAVITY AND DRAG
+***************************************/
+void computeAcceleration(const shellState & shell, double & ddx, double & ddy)
+{
+   Angle direction = Angle(0.0);
+   double gravity = gravityFromAltitude(shell.y);
+   double velocity = sqrt(shell.dx * shell.dx + shell.dy * shell.dy);
+   double dragCoefficient = dragFromMach(velocity / speedOfSoundFromAltitude(shell.y));
+   double densityOfAir = densityFromAltitude(shell.y);
+   const double area = 0.018842;
+   double dragForce = calculateDragForce(dragCoefficient, densityOfAir, velocity, area);
+   double acceleration = calculateAccelerationFromForce(dragForce);
+   direction.calculatingAngleUsingTwoComponents(shell.dx, shell.dy);
+   ddx = computeHorizontalComponent(direction, acceleration) * -1.0;
+   ddy = gravity + computeVerticalComponent(direction, acceleration) * -1.0;
+}
+
+
+/**************************************
+ADVANCE A SHELL ONE TIME INTERVAL
+***************************************/
+void stepShell(shellState & shell, double timeInterval)
+{
+   double ddx;
+   double ddy;
+   computeAcceleration(shell, ddx, ddy);
+   shell.dy = computeVelocity(shell.dy, ddy, timeInterval);
+   shell.dx = computeVelocity(shell.dx, ddx, timeInterval);
+   shell.x = calculateDisplacement(shell.x, shell.dx, ddx, timeInterval);
+   shell.y = calculateDisplacement(shell.y, shell.dy, ddy, timeInterval);
+   shell.hang += timeInterval;
+}
+
+
+/**************************************
+ADVANCE A SHELL ONE TIME INTERVAL WITH RUNGE-KUTTA
+* Four looks at the acceleration per step instead of one
+***************************************/
+void stepShellRK4(shellState & shell, double timeInterval)
+{
+   double half = timeInterval * 0.5;
+   shellState stage = shell;
+   double ax[4];
+   double ay[4];
+   double vx[4];
+   double vy[4];
+
+   vx[0] = shell.dx;
+   vy[0] = shell.dy;
+   computeAcceleration(stage, ax[0], ay[0]);
+   for (int k = 1; k < 4; k++)
+   {
+      double h = (k == 3) ? timeInterval : half;
+      stage.x = shell.x + vx[k - 1] * h;
+      stage.y = shell.y + vy[k - 1] * h;
+      stage.dx = shell.dx + ax[k - 1] * h;
+      stage.dy = shell.dy + ay[k - 1] * h;
+      vx[k] = stage.dx;
+      vy[k] = stage.dy;
+      computeAcceleration(stage, ax[k], ay[k]);
+   }
+
+   double sixth = timeInterval / 6.0;
+   shell.x += sixth * (vx[0] + 2.0 * vx[1] + 2.0 * vx[2] + vx[3]);
+   shell.y += sixth * (vy[0] + 2.0 * vy[1] + 2.0 * vy[2] + vy[3]);
+   shell.dx += sixth * (ax[0] + 2.0 * ax[1] + 2.0 * ax[2] + ax[3]);
+   shell.dy += sixth * (ay[0] + 2.0 * ay[1] + 2.0 * ay[2] + ay[3]);
+   shell.hang += timeInterval;
+}
+
+
+/**************************************
+SUMMARIZE A FLIGHT AT THE GROUND
+***************************************/
+trajectorySummary landShell(const shellState & previous, const shellState & shell, double apex)
+{
+   // The 0 represents the ground (altitude 0). The hang time is interpolated
+   // the same way so it does not jump by a whole time interval
+   trajectorySummary summary;
+   summary.distance = calculateLinearInterpolation(shell.y, shell.x, previous.y, previous.x, 0.0);
+   summary.hangTime = calculateLinearInterpolation(shell.y, shell.hang, previous.y, previous.hang, 0.0);
+   summary.apex = apex;
+   return summary;
+}
+
+
+/**************************************
+STOP RULES THAT NEVER FIRE
+***************************************/
+stopRules noStopRules()
+{
+   stopRules rules;
+   rules.maxDistance = HUGE_VAL;
+   rules.minApex = -HUGE_VAL;
+   rules.maxTime = HUGE_VAL;
+   rules.custom = NULL;
+   rules.context = NULL;
+   return rules;
+}
+
+
+/**************************************
+FLY A SHELL UNTIL IT LANDS OR A RULE FIRES
+***************************************/
+flightResult simulateShotUntil(double angle, double muzzleVelocity, const stopRules & rules,
+                               double timeInterval, stepFunction step)
+{
+   shellState shell = launchShell(angle, muzzleVelocity);
+   shellState previous = shell;
+   flightResult result;
+   result.reason = STOP_GROUND;
+   result.steps = 0;
+   double apex = 0.0;
+
+   while (shell.y >= 0)
+   {
+      previous = shell;
+      step(shell, timeInterval);
+      result.steps++;
+      if (shell.y > apex)
+         apex = shell.y;
+      if (shell.y < 0)
+         break;
+
+      // drag never turns the shell around, so x only grows
+      if (shell.x > rules.maxDistance)
+         result.reason = STOP_DISTANCE;
+      else if (shell.dy < 0 && apex < rules.minApex)
+         result.reason = STOP_LOW_APEX;
+      else if (shell.hang > rules.maxTime)
+         result.reason = STOP_TIME;
+      else if (rules.custom != NULL && rules.custom(shell, apex, rules.context))
+         result.reason = STOP_CUSTOM;
+      else
+         continue;
+
+      result.summary.distance = shell.x;
+      result.summary.hangTime = shell.hang;
+      result.summary.apex = apex;
+      return result;
+   }
+
+   result.summary = landShell(previous, shell, apex);
+   return result;
+}
+
+
+/**************************************
+FLY A SHELL UNTIL IT HITS THE GROUND
+***************************************/
+trajectorySummary simulateShot(double angle, double muzzleVelocity, double timeInterval, stepFunction step)
+{
+   return simulateShotUntil(angle, muzzleVelocity, noStopRules(), timeInterval, step).summary;
+}
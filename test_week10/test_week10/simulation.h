@@ -0,0 +1,117 @@
+/***********************************************************************
+ * Header File:
+ *    Simulation : Flies a shell from the muzzle until it hits the ground
+ * Author:
+ *    Marco Varela
+ * Summary:
+ *    The step from test_hit_the_ground_8 packaged as a library so the
+ *    tools and the game loop do not need their own copy of the loop
+ ************************************************************************/
+
+#pragma once
+#include "physics.h"
+
+
+/*********************************************
+ * STRUCTURE - SHELL STATE
+ * Position, velocity and hang time of one shell
+ *********************************************/
+struct shellState
+{
+   double x;
+   double y;
+   double dx;
+   double dy;
+   double hang;
+};
+
+
+/*********************************************
+ * STRUCTURE - TRAJECTORY SUMMARY
+ * What we care about once the shell has landed
+ *********************************************/
+struct trajectorySummary
+{
+   double distance;   // where the shell meets altitude 0 (m)
+   double hangTime;   // time of flight to that point (s)
+   double apex;       // highest altitude reached (m)
+};
+
+
+/*********************************************
+ * ENUM - STOP REASON
+ * Why a flight stopped
+ *********************************************/
+enum stopReason
+{
+   STOP_GROUND,      // it landed, the normal way
+   STOP_DISTANCE,    // it went past maxDistance, so it can only land farther
+   STOP_LOW_APEX,    // it started down without ever reaching minApex
+   STOP_TIME,        // it flew longer than maxTime
+   STOP_CUSTOM       // the caller's own test said so
+};
+
+
+/*********************************************
+ * STRUCTURE - STOP RULES
+ * Tests checked after every step so a search can drop a shot it
+ * already knows the answer for. Each is off unless set
+ *********************************************/
+struct stopRules
+{
+   double maxDistance;   // m
+   double minApex;       // m
+   double maxTime;       // s
+   bool (*custom)(const shellState & shell, double apex, void * context);
+   void * context;
+};
+
+
+/*********************************************
+ * STRUCTURE - FLIGHT RESULT
+ * The summary at the ground, or at the point the flight stopped
+ *********************************************/
+struct flightResult
+{
+   trajectorySummary summary;
+   stopReason reason;
+   long steps;
+};
+
+
+// Put a shell at the muzzle. The angle is in degrees measured from vertical, like Angle
+shellState launchShell(double angle, double muzzleVelocity);
+
+
+// One step of an integrator
+typedef void (*stepFunction)(shellState & shell, double timeInterval);
+
+
+// Acceleration on a shell from gravity and drag. ddy includes gravity
+void computeAcceleration(const shellState & shell, double & ddx, double & ddy);
+
+
+// Advance a shell one time interval using gravity, density, speed of sound and drag
+void stepShell(shellState & shell, double timeInterval);
+
+
+// Same as stepShell but with fourth order Runge-Kutta
+void stepShellRK4(shellState & shell, double timeInterval);
+
+
+// Summarize a flight from the last step above ground and the first step below it
+trajectorySummary landShell(const shellState & previous, const shellState & shell, double apex);
+
+
+// Stop rules with every test turned off
+stopRules noStopRules();
+
+
+// Fly a shell until it hits the ground or a stop rule fires
+flightResult simulateShotUntil(double angle, double muzzleVelocity, const stopRules & rules,
+                               double timeInterval = 0.01, stepFunction step = stepShell);
+
+
+// Fly a shell until it hits the ground and summarize the flight
+trajectorySummary simulateShot(double angle, double muzzleVelocity, double timeInterval = 0.01,
+                               stepFunction step = stepShell);
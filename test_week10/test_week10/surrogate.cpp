@@ -0,0 +1,303 @@
+/******************************
+* Authors:
+* Marco Varela
+* Purpose:
+* Fitting and evaluating the piecewise Chebyshev surrogate
+*******************************/
+
+#include "surrogate.h"
+#include <fstream>
+#include <iomanip>
+using namespace std;
+
+
+/**************************************
+CHEBYSHEV POLYNOMIALS T0..Tn AT t
+***************************************/
+static void chebyshevTerms(double t, int count, double * terms)
+{
+   terms[0] = 1.0;
+   if (count > 1)
+      terms[1] = t;
+   for (int k = 2; k < count; k++)
+      terms[k] = 2.0 * t * terms[k - 1] - terms[k - 2];
+}
+
+
+/**************************************
+PICK THE OUTPUT OUT OF A SUMMARY
+***************************************/
+static double summaryValue(const trajectorySummary & summary, int output)
+{
+   if (output == 0)
+      return summary.distance;
+   if (output == 1)
+      return summary.hangTime;
+   return summary.apex;
+}
+
+
+/**************************************
+SURROGATE : DEFAULT CONSTRUCTOR
+***************************************/
+Surrogate::Surrogate() :
+   angleMin(0.0), angleMax(0.0), velocityMin(0.0), velocityMax(0.0),
+   patchesAngle(0), patchesVelocity(0), degree(0)
+{
+}
+
+
+/**************************************
+SURROGATE : FIT FROM SIMULATOR SAMPLES
+***************************************/
+bool Surrogate::fit(double angleMin, double angleMax, double velocityMin, double velocityMax,
+                    int patchesAngle, int patchesVelocity, int degree)
+{
+   // the same checks load makes, and a box that is not empty
+   if (patchesAngle <= 0 || patchesVelocity <= 0 || degree < 0 || degree > MAX_DEGREE ||
+       !(angleMax > angleMin) || !(velocityMax > velocityMin))
+   {
+      coefficients.clear();
+      bounds.clear();
+      return false;
+   }
+
+   this->angleMin = angleMin;
+   this->angleMax = angleMax;
+   this->velocityMin = velocityMin;
+   this->velocityMax = velocityMax;
+   this->patchesAngle = patchesAngle;
+   this->patchesVelocity = patchesVelocity;
+   this->degree = degree;
+
+   const int n = terms();
+   const int patches = patchesAngle * patchesVelocity;
+   coefficients.assign(patches * OUTPUTS * n * n, 0.0);
+   bounds.assign(patches * OUTPUTS, 0.0);
+
+   double angleWidth = (angleMax - angleMin) / patchesAngle;
+   double velocityWidth = (velocityMax - velocityMin) / patchesVelocity;
+
+   // Chebyshev nodes of the first kind and the polynomials at each node
+   vector <double> nodes(n);
+   vector <double> nodeTerms(n * n);
+   for (int k = 0; k < n; k++)
+   {
+      nodes[k] = cos(M_PI * (k + 0.5) / n);
+      chebyshevTerms(nodes[k], n, &nodeTerms[k * n]);
+   }
+
+   vector <trajectorySummary> samples(n * n);
+   for (int pa = 0; pa < patchesAngle; pa++)
+      for (int pv = 0; pv < patchesVelocity; pv++)
+      {
+         int patch = pa * patchesVelocity + pv;
+         double a0 = angleMin + pa * angleWidth;
+         double v0 = velocityMin + pv * velocityWidth;
+
+         // sample the simulator at the nodes
+         for (int k = 0; k < n; k++)
+            for (int l = 0; l < n; l++)
+               samples[k * n + l] = simulateShot(a0 + (nodes[k] + 1.0) * 0.5 * angleWidth,
+                                                 v0 + (nodes[l] + 1.0) * 0.5 * velocityWidth);
+
+         // discrete Chebyshev transform
+         for (int output = 0; output < OUTPUTS; output++)
+            for (int i = 0; i < n; i++)
+               for (int j = 0; j < n; j++)
+               {
+                  double sum = 0.0;
+                  for (int k = 0; k < n; k++)
+                     for (int l = 0; l < n; l++)
+                        sum += summaryValue(samples[k * n + l], output) * nodeTerms[k * n + i] * nodeTerms[l * n + j];
+                  double scale = 4.0 / (n * n);
+                  if (i == 0)
+                     scale *= 0.5;
+                  if (j == 0)
+                     scale *= 0.5;
+                  coefficients[((patch * OUTPUTS + output) * n + i) * n + j] = sum * scale;
+               }
+
+         // Bound: the worst miss on a validation grid that includes the patch
+         // edges, doubled, plus the size of the highest order terms we cut off
+         vector <double> tAngle(n);
+         vector <double> tVelocity(n);
+         for (int k = 0; k <= n; k++)
+            for (int l = 0; l <= n; l++)
+            {
+               double s = -1.0 + 2.0 * k / n;
+               double t = -1.0 + 2.0 * l / n;
+               trajectorySummary truth = simulateShot(a0 + (s + 1.0) * 0.5 * angleWidth,
+                                                      v0 + (t + 1.0) * 0.5 * velocityWidth);
+               chebyshevTerms(s, n, tAngle.data());
+               chebyshevTerms(t, n, tVelocity.data());
+               for (int output = 0; output < OUTPUTS; output++)
+               {
+                  double miss = fabs(sumSeries(patch, output, tAngle.data(), tVelocity.data()) - summaryValue(truth, output));
+                  if (miss > bounds[patch * OUTPUTS + output])
+                     bounds[patch * OUTPUTS + output] = miss;
+               }
+            }
+         for (int output = 0; output < OUTPUTS; output++)
+         {
+            double tail = 0.0;
+            for (int i = 0; i < n; i++)
+               for (int j = 0; j < n; j++)
+                  if (i == n - 1 || j == n - 1)
+                     tail += fabs(coefficients[((patch * OUTPUTS + output) * n + i) * n + j]);
+            bounds[patch * OUTPUTS + output] = 2.0 * bounds[patch * OUTPUTS + output] + tail;
+         }
+      }
+   return true;
+}
+
+
+/**************************************
+SURROGATE : SUM ONE SERIES
+***************************************/
+double Surrogate::sumSeries(int patch, int output, const double * tAngle, const double * tVelocity) const
+{
+   const int n = terms();
+   const double * c = &coefficients[(patch * OUTPUTS + output) * n * n];
+   double sum = 0.0;
+   for (int i = 0; i < n; i++)
+   {
+      double row = 0.0;
+      for (int j = 0; j < n; j++)
+         row += c[i * n + j] * tVelocity[j];
+      sum += row * tAngle[i];
+   }
+   return sum;
+}
+
+
+/**************************************
+SURROGATE : EVALUATE
+***************************************/
+surrogateEstimate Surrogate::evaluate(double angle, double muzzleVelocity) const
+{
+   surrogateEstimate estimate = {};
+   estimate.inDomain = isFitted() &&
+      angle >= angleMin && angle <= angleMax &&
+      muzzleVelocity >= velocityMin && muzzleVelocity <= velocityMax;
+   if (!estimate.inDomain)
+      return estimate;
+
+   // find the patch, the upper edge belongs to the last one
+   double angleWidth = (angleMax - angleMin) / patchesAngle;
+   double velocityWidth = (velocityMax - velocityMin) / patchesVelocity;
+   int pa = (int)((angle - angleMin) / angleWidth);
+   int pv = (int)((muzzleVelocity - velocityMin) / velocityWidth);
+   if (pa >= patchesAngle)
+      pa = patchesAngle - 1;
+   if (pv >= patchesVelocity)
+      pv = patchesVelocity - 1;
+   int patch = pa * patchesVelocity + pv;
+
+   // local coordinates in [-1, 1]
+   double s = 2.0 * (angle - angleMin - pa * angleWidth) / angleWidth - 1.0;
+   double t = 2.0 * (muzzleVelocity - velocityMin - pv * velocityWidth) / velocityWidth - 1.0;
+
+   double tAngle[MAX_DEGREE + 1];
+   double tVelocity[MAX_DEGREE + 1];
+   chebyshevTerms(s, terms(), tAngle);
+   chebyshevTerms(t, terms(), tVelocity);
+
+   estimate.value.distance = sumSeries(patch, 0, tAngle, tVelocity);
+   estimate.value.hangTime = sumSeries(patch, 1, tAngle, tVelocity);
+   estimate.value.apex = sumSeries(patch, 2, tAngle, tVelocity);
+   estimate.errorBound.distance = bounds[patch * OUTPUTS + 0];
+   estimate.errorBound.hangTime = bounds[patch * OUTPUTS + 1];
+   estimate.errorBound.apex = bounds[patch * OUTPUTS + 2];
+   return estimate;
+}
+
+
+/**************************************
+SURROGATE : SAVE TO A FILE
+***************************************/
+bool Surrogate::save(const string & fileName) const
+{
+   ofstream fout(fileName.c_str());
+   if (fout.fail())
+      return false;
+
+   fout << setprecision(17);
+   fout << "surrogate 1\n";
+   fout << angleMin << ' ' << angleMax << ' ' << velocityMin << ' ' << velocityMax << '\n';
+   fout << patchesAngle << ' ' << patchesVelocity << ' ' << degree << '\n';
+   for (size_t i = 0; i < coefficients.size(); i++)
+      fout << coefficients[i] << '\n';
+   for (size_t i = 0; i < bounds.size(); i++)
+      fout << bounds[i] << '\n';
+   return !fout.fail();
+}
+
+
+/**************************************
+SURROGATE : LOAD FROM A FILE
+***************************************/
+bool Surrogate::load(const string & fileName)
+{
+   ifstream fin(fileName.c_str());
+   if (fin.fail())
+   {
+      coefficients.clear();
+      bounds.clear();
+      return false;
+   }
+
+   string tag;
+   int version = 0;
+   fin >> tag >> version;
+   if (tag != "surrogate" || version != 1)
+   {
+      coefficients.clear();
+      bounds.clear();
+      return false;
+   }
+
+   // the same checks fit makes
+   fin >> angleMin >> angleMax >> velocityMin >> velocityMax;
+   fin >> patchesAngle >> patchesVelocity >> degree;
+   if (fin.fail() || patchesAngle <= 0 || patchesVelocity <= 0 || degree < 0 || degree > MAX_DEGREE ||
+       !(angleMax > angleMin) || !(velocityMax > velocityMin))
+   {
+      coefficients.clear();
+      bounds.clear();
+      return false;
+   }
+
+   const int n = terms();
+   coefficients.resize(patchesAngle * patchesVelocity * OUTPUTS * n * n);
+   bounds.resize(patchesAngle * patchesVelocity * OUTPUTS);
+   for (size_t i = 0; i < coefficients.size(); i++)
+      fin >> coefficients[i];
+   for (size_t i = 0; i < bounds.size(); i++)
+      fin >> bounds[i];
+
+   if (fin.fail())
+   {
+      coefficients.clear();
+      bounds.clear();
+      return false;
+   }
+   return true;
+}
+
+
+/**************************************
+ESTIMATE A SHOT, FALLING BACK TO THE SIMULATION
+***************************************/
+trajectorySummary estimateShot(const Surrogate & surrogate, double angle, double muzzleVelocity,
+                               const trajectorySummary & tolerance, bool & usedSurrogate)
+{
+   surrogateEstimate estimate = surrogate.evaluate(angle, muzzleVelocity);
+   usedSurrogate = estimate.inDomain &&
+      estimate.errorBound.distance <= tolerance.distance &&
+      estimate.errorBound.hangTime <= tolerance.hangTime &&
+      estimate.errorBound.apex <= tolerance.apex;
+   if (usedSurrogate)
+      return estimate.value;
+   return simulateShot(angle, muzzleVelocity);
+}
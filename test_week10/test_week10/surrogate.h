@@ -0,0 +1,79 @@
+/***********************************************************************
+ * Header File:
+ *    Surrogate : A fitted stand-in for the full simulation
+ * Author:
+ *    Marco Varela
+ * Summary:
+ *    Piecewise Chebyshev fit of distance, hang time and apex over
+ *    (angle, muzzle velocity). Fitting is done offline from simulator
+ *    samples; evaluating is a handful of multiplies and comes with an
+ *    error bound so callers know when to fall back to simulateShot
+ ************************************************************************/
+
+#pragma once
+#include <string>
+#include "simulation.h"
+
+
+/*********************************************
+ * STRUCTURE - SURROGATE ESTIMATE
+ * The fitted values and how far off they can be
+ *********************************************/
+struct surrogateEstimate
+{
+   trajectorySummary value;
+   trajectorySummary errorBound;
+   bool inDomain;     // false when the shot is outside the fitted box
+};
+
+
+/*****************************************************
+ * SURROGATE
+ * A grid of patches over (angle, muzzle velocity). Each patch holds
+ * a tensor product Chebyshev series per output plus the worst error
+ * seen against the simulator inside that patch
+ *****************************************************/
+class Surrogate
+{
+public:
+   Surrogate();
+
+   // Sample the simulator and build the series. This is the slow, offline part.
+   // Returns false and leaves the surrogate unfitted on a bad box, patch count or degree
+   bool fit(double angleMin, double angleMax, double velocityMin, double velocityMax,
+            int patchesAngle, int patchesVelocity, int degree);
+
+   // Store and read back a fit so the game does not have to redo it
+   bool save(const string & fileName) const;
+   bool load(const string & fileName);
+
+   bool isFitted() const { return !coefficients.empty(); }
+
+   // Cheap evaluation with the bound of the patch the shot falls in
+   surrogateEstimate evaluate(double angle, double muzzleVelocity) const;
+
+private:
+   static const int OUTPUTS = 3;           // distance, hang time, apex
+   static const int MAX_DEGREE = 16;
+
+   double angleMin;
+   double angleMax;
+   double velocityMin;
+   double velocityMax;
+   int patchesAngle;
+   int patchesVelocity;
+   int degree;
+
+   // patch, output, angle term, velocity term
+   vector <double> coefficients;
+   // patch, output
+   vector <double> bounds;
+
+   int terms() const { return degree + 1; }
+   double sumSeries(int patch, int output, const double * tAngle, const double * tVelocity) const;
+};
+
+
+// Answer from the surrogate when its bound is within tolerance, otherwise run the simulation
+trajectorySummary estimateShot(const Surrogate & surrogate, double angle, double muzzleVelocity,
+                               const trajectorySummary & tolerance, bool & usedSurrogate);
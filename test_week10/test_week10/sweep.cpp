@@ -0,0 +1,272 @@
+/******************************
+* Authors:
+* Marco Varela
+* Purpose:
+* Sharded sweeps and the merge step
+*******************************/
+
+#include "sweep.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <map>
+#include <cstdio>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <process.h>
+#else
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
+using namespace std;
+
+
+/**************************************
+READ A SWEEP SPEC
+***************************************/
+bool readSweepSpec(const string & fileName, sweepSpec & spec)
+{
+   ifstream fin(fileName.c_str());
+   if (fin.fail())
+      return false;
+
+   bool haveAngle = false;
+   bool haveVelocity = false;
+   string name;
+   while (fin >> name)
+   {
+      if (name == "angle")
+         haveAngle = (bool)(fin >> spec.angleMin >> spec.angleMax >> spec.angleSteps);
+      else if (name == "velocity")
+         haveVelocity = (bool)(fin >> spec.velocityMin >> spec.velocityMax >> spec.velocitySteps);
+      else
+         return false;
+   }
+   return haveAngle && haveVelocity && spec.angleSteps > 0 && spec.velocitySteps > 0;
+}
+
+
+/**************************************
+NUMBER OF SHOTS IN A SWEEP
+***************************************/
+long sweepSize(const sweepSpec & spec)
+{
+   return (long)spec.angleSteps * spec.velocitySteps;
+}
+
+
+/**************************************
+THE SHOT AT AN INDEX
+***************************************/
+void sweepPoint(const sweepSpec & spec, long index, double & angle, double & muzzleVelocity)
+{
+   int a = (int)(index / spec.velocitySteps);
+   int v = (int)(index % spec.velocitySteps);
+   angle = spec.angleSteps > 1 ?
+      calculateLinearInterpolation(0, spec.angleMin, spec.angleSteps - 1, spec.angleMax, a) : spec.angleMin;
+   muzzleVelocity = spec.velocitySteps > 1 ?
+      calculateLinearInterpolation(0, spec.velocityMin, spec.velocitySteps - 1, spec.velocityMax, v) : spec.velocityMin;
+}
+
+
+/**************************************
+INDEX RANGE OF ONE SHARD
+***************************************/
+void shardRange(long total, int shard, int shards, long & first, long & last)
+{
+   first = total * shard / shards;
+   last = total * (shard + 1) / shards;
+}
+
+
+/**************************************
+FLY ONE SHARD
+***************************************/
+bool runShard(const sweepSpec & spec, int shard, int shards, const string & fileName)
+{
+   if (shards < 1 || shard < 0 || shard >= shards)
+      return false;
+
+   long first;
+   long last;
+   shardRange(sweepSize(spec), shard, shards, first, last);
+
+   // write under a temporary name so a crashed worker never leaves a
+   // half written file that looks finished
+   string partial = fileName + ".partial";
+   ofstream fout(partial.c_str());
+   if (fout.fail())
+      return false;
+
+   fout << setprecision(17);
+   for (long index = first; index < last; index++)
+   {
+      double angle;
+      double muzzleVelocity;
+      sweepPoint(spec, index, angle, muzzleVelocity);
+      trajectorySummary summary = simulateShot(angle, muzzleVelocity);
+      fout << index << ' ' << angle << ' ' << muzzleVelocity << ' '
+           << summary.distance << ' ' << summary.hangTime << ' ' << summary.apex << '\n';
+   }
+   fout.close();
+   if (fout.fail())
+      return false;
+
+   remove(fileName.c_str());
+   return rename(partial.c_str(), fileName.c_str()) == 0;
+}
+
+
+/**************************************
+MERGE SHARD FILES
+***************************************/
+bool mergeShards(const vector <string> & inputs, const string & output)
+{
+   // keyed by index, so the rows come out sorted and repeats collapse
+   map <long, string> rows;
+   for (size_t i = 0; i < inputs.size(); i++)
+   {
+      ifstream fin(inputs[i].c_str());
+      if (fin.fail())
+         return false;
+
+      string line;
+      while (getline(fin, line))
+      {
+         if (line.empty() || line[0] == '#')
+            continue;
+         long index;
+         istringstream row(line);
+         if (!(row >> index))
+            return false;
+         rows.insert(make_pair(index, line));
+      }
+   }
+
+   ofstream fout(output.c_str());
+   if (fout.fail())
+      return false;
+   fout << "# index angle velocity distance hangTime apex\n";
+   for (map <long, string> ::const_iterator it = rows.begin(); it != rows.end(); ++it)
+      fout << it->second << '\n';
+   return !fout.fail();
+}
+
+
+/**************************************
+THE PATH OF THE RUNNING PROGRAM
+***************************************/
+string programPath(const string & fallback)
+{
+#ifdef _WIN32
+   char path[MAX_PATH];
+   DWORD length = GetModuleFileNameA(NULL, path, MAX_PATH);
+   if (length > 0 && length < MAX_PATH)
+      return string(path, length);
+#elif defined(__linux__)
+   char path[4096];
+   ssize_t length = readlink("/proc/self/exe", path, sizeof(path));
+   if (length > 0 && length < (ssize_t)sizeof(path))
+      return string(path, length);
+#endif
+   return fallback;
+}
+
+
+/**************************************
+START ONE WORKER PROCESS
+* The p versions search PATH when the program has no directory in it
+***************************************/
+#ifdef _WIN32
+typedef intptr_t worker;
+#else
+typedef pid_t worker;
+#endif
+
+static bool startWorker(const string & program, const vector <string> & arguments, worker & process)
+{
+   vector <const char *> argv;
+   argv.push_back(program.c_str());
+   for (size_t i = 0; i < arguments.size(); i++)
+      argv.push_back(arguments[i].c_str());
+   argv.push_back(NULL);
+
+#ifdef _WIN32
+   process = _spawnvp(_P_NOWAIT, program.c_str(), &argv[0]);
+   return process != -1;
+#else
+   process = fork();
+   if (process == 0)
+   {
+      execvp(program.c_str(), (char * const *)&argv[0]);
+      _exit(127);
+   }
+   return process > 0;
+#endif
+}
+
+
+/**************************************
+WAIT FOR A WORKER. TRUE IF IT SUCCEEDED
+***************************************/
+static bool waitForWorker(worker process)
+{
+#ifdef _WIN32
+   int status = 0;
+   return _cwait(&status, process, 0) != -1 && status == 0;
+#else
+   int status = 0;
+   return waitpid(process, &status, 0) == process && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+#endif
+}
+
+
+/**************************************
+RUN A SWEEP OVER SEVERAL PROCESSES
+***************************************/
+bool runShardedSweep(const string & program, const string & specFile, int shards, const string & output)
+{
+   if (shards < 1)
+      return false;
+
+   vector <string> files;
+   vector <worker> workers;
+   bool success = true;
+   for (int shard = 0; shard < shards; shard++)
+   {
+      ostringstream name;
+      name << output << ".shard" << shard;
+      files.push_back(name.str());
+
+      ostringstream shardText;
+      ostringstream shardsText;
+      shardText << shard;
+      shardsText << shards;
+      vector <string> arguments;
+      arguments.push_back("shard");
+      arguments.push_back(specFile);
+      arguments.push_back(shardText.str());
+      arguments.push_back(shardsText.str());
+      arguments.push_back(files.back());
+
+      worker process;
+      if (startWorker(program, arguments, process))
+         workers.push_back(process);
+      else
+         success = false;
+   }
+
+   for (size_t i = 0; i < workers.size(); i++)
+      if (!waitForWorker(workers[i]))
+         success = false;
+
+   if (!success || !mergeShards(files, output))
+      return false;
+
+   // the merged table has everything, so the shard files can go
+   for (size_t i = 0; i < files.size(); i++)
+      remove(files[i].c_str());
+   return true;
+}
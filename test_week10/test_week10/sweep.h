@@ -0,0 +1,66 @@
+/***********************************************************************
+ * Header File:
+ *    Sweep : Run a grid of shots, split over several processes
+ * Author:
+ *    Marco Varela
+ * Summary:
+ *    A sweep spec is a grid of (angle, muzzle velocity). Every point
+ *    has a fixed index, so the grid can be cut into shards by index
+ *    range, each shard written to its own file by its own process,
+ *    and the files merged back into one table sorted by index
+ ************************************************************************/
+
+#pragma once
+#include <string>
+#include "simulation.h"
+
+
+/*********************************************
+ * STRUCTURE - SWEEP SPEC
+ * The grid of shots. Read from a file like:
+ *    angle 10 80 71
+ *    velocity 200 900 15
+ *********************************************/
+struct sweepSpec
+{
+   double angleMin;
+   double angleMax;
+   int angleSteps;
+   double velocityMin;
+   double velocityMax;
+   int velocitySteps;
+};
+
+
+// Read a spec file. Returns false if it is missing or malformed
+bool readSweepSpec(const string & fileName, sweepSpec & spec);
+
+
+// Number of shots in the sweep
+long sweepSize(const sweepSpec & spec);
+
+
+// The shot at an index, angles vary slowest
+void sweepPoint(const sweepSpec & spec, long index, double & angle, double & muzzleVelocity);
+
+
+// Index range [first, last) for one shard out of shards
+void shardRange(long total, int shard, int shards, long & first, long & last);
+
+
+// Fly one shard and write its rows to a file
+bool runShard(const sweepSpec & spec, int shard, int shards, const string & fileName);
+
+
+// Combine shard files into one table sorted by index, dropping repeated indexes
+bool mergeShards(const vector <string> & inputs, const string & output);
+
+
+// Where the running program lives, so it can be started again as a worker.
+// Returns fallback where the platform cannot say
+string programPath(const string & fallback);
+
+
+// Start one worker process per shard running "program shard ...", wait for
+// them, merge their files into output and remove the shard files
+bool runShardedSweep(const string & program, const string & specFile, int shards, const string & output);
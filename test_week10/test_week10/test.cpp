@@ -9,6 +9,17 @@
 
 #include "test.h"
 #include "testPhysics.h"           // Unit tests created by Marco Varela
+#include "testSurrogate.h"
+#include "testScheduler.h"
+#include "testShellPool.h"
+#include "testSweep.h"
+#include "testConvergence.h"
+#include "testFireSolution.h"
+#include "testTrajectoryCache.h"
+#include "testDragTable.h"
+#include "testBatchPlanner.h"
+#include "testEarlyExit.h"
+#include "testWorkerPool.h"
 
 
  /*****************************************************************
@@ -18,5 +29,16 @@
 void testRunner()
 {
    TestPhysics().run();
+   TestSurrogate().run();
+   TestScheduler().run();
+   TestShellPool().run();
+   TestSweep().run();
+   TestConvergence().run();
+   TestFireSolution().run();
+   TestTrajectoryCache().run();
+   TestDragTable().run();
+   TestBatchPlanner().run();
+   TestEarlyExit().run();
+   TestWorkerPool().run();
    /*TestVelocity().run();*/
 }
@@ -0,0 +1,128 @@
+/***********************************************************************
+ * Header File:
+ *    Test Batch Planner : Test the hang time ordering and the lanes
+ * Author:
+ *    Marco Varela
+ * Summary:
+ *    Unit tests for BatchPlanner
+ ************************************************************************/
+
+#pragma once
+
+#include <iostream>
+#include <cassert>
+#include "batchPlanner.h"
+#include "dragTable.h"
+using namespace std;
+
+
+/*****************************************************
+ * TEST BATCH PLANNER
+ * A class that contains the Batch Planner unit tests
+ *****************************************************/
+class TestBatchPlanner
+{
+public:
+   void run()
+   {
+      test_batchPlanner_plan();
+      test_batchPlanner_matchesSimulateShot();
+      test_batchPlanner_fullLanes();
+      test_batchPlanner_refillHelps();
+      cout << "All the test cases for testBatchPlanner.h have been successfull!\n";
+   }
+private:
+
+   // utility funciton because floating point numbers are approximations
+   bool closeEnough(double value, double test, double tolerence) const
+   {
+      double difference = value - test;
+      return (difference >= -tolerence) && (difference <= tolerence);
+   }
+
+   // short, long and in between flights, mixed up
+   vector <batchShot> mixedShots()
+   {
+      vector <batchShot> shots;
+      for (int i = 0; i < 12; i++)
+      {
+         batchShot shot = { (i % 3 == 0) ? 85.0 : 20.0 + i * 4.0, 300.0 + 40.0 * (i % 4) };
+         shots.push_back(shot);
+      }
+      return shots;
+   }
+
+   /*****************************************************
+    * TESTING THE PLAN
+    *****************************************************/
+   void test_batchPlanner_plan()
+   {
+      // setup
+      BatchPlanner planner;
+      vector <batchShot> shots = mixedShots();
+      // exercise
+      vector <int> order = planner.plan(shots);
+      // verify: every shot once, longest first
+      assert(order.size() == shots.size());
+      for (size_t i = 1; i < order.size(); i++)
+         assert(planner.estimateHangTime(shots[order[i - 1]]) >= planner.estimateHangTime(shots[order[i]]));
+      // straight up at 100 m/s is about 20 s with no air
+      batchShot up = { 0.0, 100.0 };
+      assert(closeEnough(planner.estimateHangTime(up), 20.39, 0.01));
+   }
+
+   /*****************************************************
+    * TESTING THE LANES
+    *****************************************************/
+   void test_batchPlanner_matchesSimulateShot()
+   {
+      // setup
+      BatchPlanner planner(4);
+      vector <batchShot> shots = mixedShots();
+      vector <trajectorySummary> results;
+      // exercise
+      planner.run(shots, results);
+      // verify: the lanes step exactly like stepShellTable
+      for (size_t i = 0; i < shots.size(); i++)
+      {
+         trajectorySummary expected = simulateShot(shots[i].angle, shots[i].muzzleVelocity, 0.01, stepShellTable);
+         assert(closeEnough(results[i].distance, expected.distance, 1e-9));
+         assert(closeEnough(results[i].hangTime, expected.hangTime, 1e-9));
+         assert(closeEnough(results[i].apex, expected.apex, 1e-9));
+      }
+   }
+
+   void test_batchPlanner_fullLanes()
+   {
+      // setup: eight identical shots in eight lanes
+      BatchPlanner planner(8);
+      vector <batchShot> shots(8);
+      for (size_t i = 0; i < shots.size(); i++)
+      {
+         shots[i].angle = 60.0;
+         shots[i].muzzleVelocity = 300.0;
+      }
+      vector <trajectorySummary> results;
+      // exercise
+      batchReport report = planner.run(shots, results);
+      // verify
+      assert(closeEnough(report.utilization, 1.0, 1e-12));
+      assert(report.laneSteps == report.steps * 8);
+   }
+
+   void test_batchPlanner_refillHelps()
+   {
+      // setup
+      BatchPlanner planner(4);
+      vector <batchShot> shots = mixedShots();
+      vector <trajectorySummary> results;
+      // exercise
+      batchReport plain = planner.run(shots, results, false, false);
+      batchReport planned = planner.run(shots, results, true, true);
+      // verify: same work, fewer passes
+      assert(plain.activeLaneSteps == planned.activeLaneSteps);
+      assert(planned.steps < plain.steps);
+      assert(planned.utilization > plain.utilization);
+      assert(planned.utilization > 0.8);
+   }
+};
@@ -0,0 +1,97 @@
+/***********************************************************************
+ * Header File:
+ *    Test Convergence : Test the accuracy-vs-cost harness
+ * Author:
+ *    Marco Varela
+ * Summary:
+ *    Unit tests for the reference shot and the convergence results
+ ************************************************************************/
+
+#pragma once
+
+#include <iostream>
+#include <cassert>
+#include "convergence.h"
+using namespace std;
+
+
+/*****************************************************
+ * TEST CONVERGENCE
+ * A class that contains the Convergence unit tests
+ *****************************************************/
+class TestConvergence
+{
+public:
+   void run()
+   {
+      test_referenceShot_converged();
+      test_runConvergence_orders();
+      test_cheapestWithin();
+      cout << "All the test cases for testConvergence.h have been successfull!\n";
+   }
+private:
+
+   // utility funciton because floating point numbers are approximations
+   bool closeEnough(double value, double test, double tolerence) const
+   {
+      double difference = value - test;
+      return (difference >= -tolerence) && (difference <= tolerence);
+   }
+
+   /*****************************************************
+    * TESTING THE REFERENCE
+    *****************************************************/
+   void test_referenceShot_converged()
+   {
+      // exercise
+      trajectorySummary coarse = referenceShot(75.0, 827.0, 2e-3L);
+      trajectorySummary fine = referenceShot(75.0, 827.0, 1e-3L);
+      // verify: halving the step barely moves it, and it is near the prototype's answer
+      assert(closeEnough(coarse.distance, fine.distance, 0.01));
+      assert(closeEnough(coarse.hangTime, fine.hangTime, 0.0001));
+      assert(closeEnough(fine.distance, 14571.7, 50.0));
+   }
+
+   /*****************************************************
+    * TESTING THE RESULTS
+    *****************************************************/
+   void test_runConvergence_orders()
+   {
+      // setup
+      vector <convergenceShot> shots(1);
+      shots[0].angle = 75.0;
+      shots[0].muzzleVelocity = 827.0;
+      vector <double> intervals;
+      intervals.push_back(0.02);
+      intervals.push_back(0.01);
+      // exercise
+      vector <convergenceResult> results = runConvergence(shots, defaultConvergenceVariants(), intervals, 1e-3L);
+      // verify: stepShell, rk4 then dragTable, each at 0.02 then 0.01
+      assert(results.size() == 6);
+      assert(results[0].name == "stepShell" && results[3].name == "rk4");
+      // stepShell is first order, so half the step is about half the error
+      assert(closeEnough(results[1].distanceError / results[0].distanceError, 0.5, 0.1));
+      // rk4 beats it by a wide margin at the same step
+      assert(results[3].distanceError * 100.0 < results[1].distanceError);
+      assert(results[0].seconds > 0.0);
+   }
+
+   void test_cheapestWithin()
+   {
+      // setup
+      vector <convergenceResult> results(3);
+      results[0].distanceError = 10.0;
+      results[0].hangTimeError = 0.0;
+      results[0].seconds = 1.0;
+      results[1].distanceError = 0.5;
+      results[1].hangTimeError = 0.001;
+      results[1].seconds = 3.0;
+      results[2].distanceError = 0.1;
+      results[2].hangTimeError = 0.001;
+      results[2].seconds = 2.0;
+      // exercise and verify
+      assert(cheapestWithin(results, 1.0, 0.01) == 2);
+      assert(cheapestWithin(results, 100.0, 0.01) == 0);
+      assert(cheapestWithin(results, 0.01, 0.01) == -1);
+   }
+};
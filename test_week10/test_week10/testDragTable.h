@@ -0,0 +1,158 @@
+/***********************************************************************
+ * Header File:
+ *    Test Drag Table : Test the precomputed drag table
+ * Author:
+ *    Marco Varela
+ * Summary:
+ *    Unit tests for DragTable and stepShellTable
+ ************************************************************************/
+
+#pragma once
+
+#include <iostream>
+#include <cassert>
+#include "dragTable.h"
+using namespace std;
+
+
+/*****************************************************
+ * TEST DRAG TABLE
+ * A class that contains the Drag Table unit tests
+ *****************************************************/
+class TestDragTable
+{
+public:
+   void run()
+   {
+      test_dragTable_matchesChainOnGrid();
+      test_dragTable_matchesStep();
+      test_dragTable_error();
+      test_dragTable_rebuildsOnMet();
+      test_dragTable_keyedOnMetValues();
+      test_defaultDragTable_followsMet();
+      test_dragTable_rebuildsOnShell();
+      cout << "All the test cases for testDragTable.h have been successfull!\n";
+   }
+private:
+
+   // utility funciton because floating point numbers are approximations
+   bool closeEnough(double value, double test, double tolerence) const
+   {
+      double difference = value - test;
+      return (difference >= -tolerence) && (difference <= tolerence);
+   }
+
+   /*****************************************************
+    * TESTING THE LOOKUP
+    *****************************************************/
+   void test_dragTable_matchesChainOnGrid()
+   {
+      // setup
+      const DragTable & table = defaultDragTable();
+      // exercise
+      double lookup = table.dragPerSpeedSquared(3000.0, 240.0);
+      // verify: on a grid point it is the chain, which is test_calculateDragForce_peak's force
+      assert(closeEnough(lookup, table.dragPerSpeedSquaredChain(3000.0, 240.0), 1e-15));
+      assert(closeEnough(lookup * 240.0 * 240.0 * 46.7,
+                         calculateDragForce(dragFromMach(240.0 / 328.0), 0.9093, 240.0, 0.018842), 1e-9));
+   }
+
+   void test_dragTable_matchesStep()
+   {
+      // setup
+      shellState shell = launchShell(75.0, 827.0);
+      shell.y = 1234.0;
+      double ddx;
+      double ddy;
+      double tableDdx;
+      double tableDdy;
+      // exercise
+      computeAcceleration(shell, ddx, ddy);
+      computeAccelerationFromTable(defaultDragTable(), shell, tableDdx, tableDdy);
+      // verify
+      assert(closeEnough(tableDdx, ddx, fabs(ddx) * 0.001));
+      assert(closeEnough(tableDdy, ddy, fabs(ddy) * 0.001));
+      assert(closeEnough(simulateShot(75.0, 827.0, 0.01, stepShellTable).distance,
+                         simulateShot(75.0, 827.0).distance, 1.0));
+   }
+
+   void test_dragTable_error()
+   {
+      // exercise
+      dragTableError error = defaultDragTable().measureError(10000);
+      // verify: worst near the Mach 1 corners of the drag table, small on average
+      assert(error.maximum < 0.05);
+      assert(error.mean < 0.001);
+   }
+
+   /*****************************************************
+    * TESTING REBUILDS
+    *****************************************************/
+   void test_dragTable_rebuildsOnMet()
+   {
+      // setup
+      DragTable table(46.7, 0.018842, 5000.0, 100.0, 1000.0, 10.0);
+      metData heavy = { 1.1, 1.0 };
+      metData standard = { 1.0, 1.0 };
+      double before = table.dragPerSpeedSquared(0.0, 500.0);
+      // exercise
+      table.rebuildIfStale();
+      assert(table.getBuilds() == 1);
+      setMetData(heavy);
+      table.rebuildIfStale();
+      double after = table.dragPerSpeedSquared(0.0, 500.0);
+      setMetData(standard);
+      // verify
+      assert(table.getBuilds() == 2);
+      assert(closeEnough(after, before * 1.1, 1e-12));
+   }
+
+   void test_defaultDragTable_followsMet()
+   {
+      // setup
+      metData standard = { 1.0, 1.0 };
+      metData heavy = { 1.2, 1.0 };
+      double before = simulateShot(75.0, 827.0, 0.01, stepShellTable).distance;
+      // exercise: no rebuild by hand
+      setMetData(heavy);
+      double table = simulateShot(75.0, 827.0, 0.01, stepShellTable).distance;
+      double chain = simulateShot(75.0, 827.0).distance;
+      bool fresh = defaultDragTable().isBuiltFor(heavy);
+      setMetData(standard);
+      // verify: the table followed the met data, and back again
+      assert(fresh);
+      assert(closeEnough(table, chain, 1.0));
+      assert(table < before - 1000.0);
+      assert(closeEnough(simulateShot(75.0, 827.0, 0.01, stepShellTable).distance, before, 1e-9));
+   }
+
+   void test_dragTable_keyedOnMetValues()
+   {
+      // setup
+      DragTable table(46.7, 0.018842, 5000.0, 100.0, 1000.0, 10.0);
+      metData standard = getMetData();
+      metData nudged = standard;
+      nudged.densityFactor += 0.001;
+      // exercise: nudge the met data and put it back, like measureMetSensitivity
+      setMetData(nudged);
+      setMetData(standard);
+      table.rebuildIfStale();
+      setMetData(standard);
+      table.rebuildIfStale();
+      // verify: no net change, no rebuild
+      assert(table.getBuilds() == 1);
+   }
+
+   void test_dragTable_rebuildsOnShell()
+   {
+      // setup
+      DragTable table(46.7, 0.018842, 5000.0, 100.0, 1000.0, 10.0);
+      double before = table.dragPerSpeedSquared(0.0, 500.0);
+      // exercise
+      table.setShell(46.7, 0.018842);
+      table.setShell(93.4, 0.018842);
+      // verify: twice the mass, half the deceleration
+      assert(table.getBuilds() == 2);
+      assert(closeEnough(table.dragPerSpeedSquared(0.0, 500.0), before * 0.5, 1e-12));
+   }
+};
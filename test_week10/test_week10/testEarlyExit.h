@@ -0,0 +1,136 @@
+/***********************************************************************
+ * Header File:
+ *    Test Early Exit : Test the stop rules
+ * Author:
+ *    Marco Varela
+ * Summary:
+ *    Unit tests for simulateShotUntil and the bisection search that uses it
+ ************************************************************************/
+
+#pragma once
+
+#include <iostream>
+#include <cassert>
+#include "fireSolution.h"
+using namespace std;
+
+
+/*****************************************************
+ * TEST EARLY EXIT
+ * A class that contains the stop rule unit tests
+ *****************************************************/
+class TestEarlyExit
+{
+public:
+   void run()
+   {
+      test_noStopRules_lands();
+      test_stop_distance();
+      test_stop_lowApex();
+      test_stop_time();
+      test_stop_custom();
+      test_bisect_savesSteps();
+      cout << "All the test cases for testEarlyExit.h have been successfull!\n";
+   }
+private:
+
+   // utility funciton because floating point numbers are approximations
+   bool closeEnough(double value, double test, double tolerence) const
+   {
+      double difference = value - test;
+      return (difference >= -tolerence) && (difference <= tolerence);
+   }
+
+   // stops once the shell is higher than the number in context
+   static bool aboveAltitude(const shellState & shell, double, void * context)
+   {
+      return shell.y > *(double *)context;
+   }
+
+   /*****************************************************
+    * TESTING THE RULES
+    *****************************************************/
+   void test_noStopRules_lands()
+   {
+      // exercise
+      flightResult flight = simulateShotUntil(75.0, 827.0, noStopRules());
+      // verify: the same numbers test_hit_the_ground_8 prints
+      assert(flight.reason == STOP_GROUND);
+      assert(closeEnough(flight.summary.distance, 14571.7, 0.1));
+      assert(flight.steps == 3352);
+   }
+
+   void test_stop_distance()
+   {
+      // setup
+      stopRules rules = noStopRules();
+      rules.maxDistance = 5000.0;
+      // exercise
+      flightResult flight = simulateShotUntil(75.0, 827.0, rules);
+      // verify: stopped on the way up, just past the line
+      assert(flight.reason == STOP_DISTANCE);
+      assert(flight.summary.distance > 5000.0 && flight.summary.distance < 5010.0);
+      assert(flight.steps < 3352 / 2);
+   }
+
+   void test_stop_lowApex()
+   {
+      // setup: the 75 degree shot tops out around 1400 m
+      stopRules rules = noStopRules();
+      rules.minApex = 2000.0;
+      // exercise
+      flightResult flight = simulateShotUntil(75.0, 827.0, rules);
+      // verify
+      assert(flight.reason == STOP_LOW_APEX);
+      assert(flight.summary.apex < 2000.0);
+      rules.minApex = 1000.0;
+      assert(simulateShotUntil(75.0, 827.0, rules).reason == STOP_GROUND);
+   }
+
+   void test_stop_time()
+   {
+      // setup
+      stopRules rules = noStopRules();
+      rules.maxTime = 10.0;
+      // exercise
+      flightResult flight = simulateShotUntil(75.0, 827.0, rules);
+      // verify
+      assert(flight.reason == STOP_TIME);
+      assert(closeEnough(flight.summary.hangTime, 10.0, 0.011));
+   }
+
+   void test_stop_custom()
+   {
+      // setup
+      double ceiling = 500.0;
+      stopRules rules = noStopRules();
+      rules.custom = aboveAltitude;
+      rules.context = &ceiling;
+      // exercise
+      flightResult flight = simulateShotUntil(75.0, 827.0, rules);
+      // verify
+      assert(flight.reason == STOP_CUSTOM);
+      assert(flight.summary.apex > 500.0 && flight.summary.apex < 510.0);
+   }
+
+   /*****************************************************
+    * TESTING THE SEARCH
+    *****************************************************/
+   void test_bisect_savesSteps()
+   {
+      // setup
+      int shotsEarly = 0;
+      int shotsFull = 0;
+      long stepsEarly = 0;
+      long stepsFull = 0;
+      // exercise: low angle fire between the greatest range and nearly flat
+      fireSolution early = solveFireSolutionBisect(14571.7, 827.0, 50.0, 89.0, 1.0, shotsEarly, stepsEarly, true);
+      fireSolution full = solveFireSolutionBisect(14571.7, 827.0, 50.0, 89.0, 1.0, shotsFull, stepsFull, false);
+      // verify: the same answer for fewer steps
+      assert(early.solved && full.solved);
+      assert(closeEnough(early.angle, 75.0, 0.01));
+      assert(closeEnough(early.angle, full.angle, 1e-12));
+      assert(shotsEarly == shotsFull);
+      assert(stepsEarly < stepsFull);
+   }
+};
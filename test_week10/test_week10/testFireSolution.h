@@ -0,0 +1,156 @@
+/***********************************************************************
+ * Header File:
+ *    Test Fire Solution : Test the solver and the met re-solve
+ * Author:
+ *    Marco Varela
+ * Summary:
+ *    Unit tests for solveFireSolution and FireSolutionStore
+ ************************************************************************/
+
+#pragma once
+
+#include <iostream>
+#include <cassert>
+#include <thread>
+#include "fireSolution.h"
+using namespace std;
+
+
+/*****************************************************
+ * TEST FIRE SOLUTION
+ * A class that contains the Fire Solution unit tests
+ *****************************************************/
+class TestFireSolution
+{
+public:
+   void run()
+   {
+      test_solveFireSolution_hitsTarget();
+      test_metData_changesDensity();
+      test_metData_perThread();
+      test_store_smallChangeSkips();
+      test_store_largeChangeWarmStarts();
+      cout << "All the test cases for testFireSolution.h have been successfull!\n";
+   }
+private:
+
+   // utility funciton because floating point numbers are approximations
+   bool closeEnough(double value, double test, double tolerence) const
+   {
+      double difference = value - test;
+      return (difference >= -tolerence) && (difference <= tolerence);
+   }
+
+   metData standardDay()
+   {
+      metData met = { 1.0, 1.0 };
+      return met;
+   }
+
+   /*****************************************************
+    * TESTING THE SOLVER
+    *****************************************************/
+   void test_solveFireSolution_hitsTarget()
+   {
+      // setup
+      int shots = 0;
+      // exercise
+      fireSolution solution = solveFireSolution(14571.7, 827.0, 70.0, 0.0, 1.0, shots);
+      // verify: the shot test_hit_the_ground_8 makes
+      assert(solution.solved);
+      assert(closeEnough(solution.angle, 75.0, 0.01));
+      assert(closeEnough(simulateShot(solution.angle, 827.0).distance, 14571.7, 1.0));
+      assert(solution.distancePerAngle < 0.0);
+      assert(shots > 1 && shots < 10);
+   }
+
+   void test_metData_changesDensity()
+   {
+      // setup
+      metData heavy = { 1.1, 1.0 };
+      double standard = densityFromAltitude(1000.0);
+      // exercise
+      setMetData(heavy);
+      double corrected = densityFromAltitude(1000.0);
+      setMetData(standardDay());
+      // verify
+      assert(closeEnough(corrected, standard * 1.1, 1e-12));
+   }
+
+   static void readDensity(double * density)
+   {
+      *density = densityFromAltitude(1000.0);
+   }
+
+   void test_metData_perThread()
+   {
+      // setup
+      metData heavy = { 1.1, 1.0 };
+      double standard = densityFromAltitude(1000.0);
+      double elsewhere = 0.0;
+      // exercise: only this thread reads the heavy met data
+      const metData * outer = useMetData(&heavy);
+      double here = densityFromAltitude(1000.0);
+      thread other(readDensity, &elsewhere);
+      other.join();
+      useMetData(outer);
+      // verify
+      assert(outer == NULL);
+      assert(closeEnough(here, standard * 1.1, 1e-12));
+      assert(closeEnough(elsewhere, standard, 1e-12));
+      assert(closeEnough(densityFromAltitude(1000.0), standard, 1e-12));
+   }
+
+   /*****************************************************
+    * TESTING THE STORE
+    *****************************************************/
+   void test_store_smallChangeSkips()
+   {
+      // setup
+      setMetData(standardDay());
+      FireSolutionStore store(1.0);
+      store.add(12000.0, 827.0);
+      assert(store.getShots() > 2 && store.getResolved() == 1);
+      store.add(15000.0, 827.0);
+      // the sensitivities were measured without touching the shared met data
+      assert(getMetData().densityFactor == 1.0 && getMetData().speedOfSoundFactor == 1.0);
+      metData nudge = { 1.00002, 1.0 };
+      // exercise
+      store.updateMet(nudge);
+      // verify: nothing to do, and the old angles still land close enough
+      assert(store.getSkipped() == 2);
+      assert(store.getShots() == 0);
+      for (int i = 0; i < store.size(); i++)
+         assert(closeEnough(simulateShot(store.get(i).angle, 827.0).distance, store.get(i).targetDistance, 1.0));
+      // teardown
+      setMetData(standardDay());
+   }
+
+   void test_store_largeChangeWarmStarts()
+   {
+      // setup
+      setMetData(standardDay());
+      FireSolutionStore store(1.0);
+      store.add(10000.0, 827.0);
+      store.add(13000.0, 827.0);
+      store.add(16000.0, 827.0);
+      metData front = { 1.03, 0.99 };
+      // exercise
+      store.updateMet(front);
+      int incrementalShots = store.getShots();
+      vector <double> angles;
+      for (int i = 0; i < store.size(); i++)
+         angles.push_back(store.get(i).angle);
+      store.recomputeAll(front);
+      // verify: same answers for much less work
+      assert(store.getResolved() == 3);
+      assert(incrementalShots * 2 < store.getShots());
+      for (int i = 0; i < store.size(); i++)
+      {
+         assert(store.get(i).solved);
+         assert(closeEnough(simulateShot(angles[i], 827.0).distance, store.get(i).targetDistance, 1.0));
+      }
+      // teardown
+      setMetData(standardDay());
+   }
+};
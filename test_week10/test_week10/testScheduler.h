@@ -0,0 +1,160 @@
+/***********************************************************************
+ * Header File:
+ *    Test Scheduler : Test the resumable flights and the scheduler
+ * Author:
+ *    Marco Varela
+ * Summary:
+ *    Unit tests for ShellFlight and FlightScheduler
+ ************************************************************************/
+
+#pragma once
+
+#include <iostream>
+#include <cassert>
+#include "scheduler.h"
+using namespace std;
+
+
+/*****************************************************
+ * TEST SCHEDULER
+ * A class that contains the Scheduler unit tests
+ *****************************************************/
+class TestScheduler
+{
+public:
+   void run()
+   {
+      test_shellFlight_matchesSimulateShot();
+      test_shellFlight_interpolate();
+      test_scheduler_catchesUp();
+      test_scheduler_zeroBudget();
+      test_scheduler_fairAcrossFrames();
+      test_scheduler_renderBetweenTicks();
+      test_scheduler_landedShell();
+      cout << "All the test cases for testScheduler.h have been successfull!\n";
+   }
+private:
+
+   // utility funciton because floating point numbers are approximations
+   bool closeEnough(double value, double test, double tolerence) const
+   {
+      double difference = value - test;
+      return (difference >= -tolerence) && (difference <= tolerence);
+   }
+
+   /*****************************************************
+    * TESTING SHELL FLIGHT
+    *****************************************************/
+   void test_shellFlight_matchesSimulateShot()
+   {
+      // setup
+      ShellFlight flight(75.0, 827.0);
+      // exercise
+      while (flight.step())
+         ;
+      // verify
+      trajectorySummary expected = simulateShot(75.0, 827.0);
+      assert(flight.hasLanded());
+      assert(!flight.step());
+      assert(closeEnough(flight.getSummary().distance, expected.distance, 1e-9));
+      assert(closeEnough(flight.getSummary().hangTime, expected.hangTime, 1e-9));
+      assert(closeEnough(flight.getSummary().apex, expected.apex, 1e-9));
+   }
+
+   void test_shellFlight_interpolate()
+   {
+      // setup
+      ShellFlight flight(75.0, 827.0);
+      flight.step();
+      // exercise
+      shellState middle = flight.interpolate(0.5);
+      // verify
+      assert(closeEnough(middle.x, flight.getCurrent().x * 0.5, 1e-9));
+      assert(closeEnough(middle.hang, 0.005, 1e-9));
+      assert(closeEnough(flight.interpolate(7.0).x, flight.getCurrent().x, 1e-9));
+   }
+
+   /*****************************************************
+    * TESTING FLIGHT SCHEDULER
+    *****************************************************/
+   void test_scheduler_catchesUp()
+   {
+      // setup
+      FlightScheduler scheduler;
+      int first = scheduler.launch(75.0, 827.0);
+      int second = scheduler.launch(60.0, 500.0);
+      // exercise: one 60 Hz frame with all the time in the world
+      int steps = scheduler.advance(1.0 / 60.0, 1.0);
+      // verify: 0.0167 s needs two 0.01 s steps for each shell
+      assert(steps == 4);
+      assert(closeEnough(scheduler.renderPosition(first).hang, 1.0 / 60.0, 1e-9));
+      assert(closeEnough(scheduler.renderPosition(second).hang, 1.0 / 60.0, 1e-9));
+      assert(scheduler.inFlight() == 2);
+   }
+
+   void test_scheduler_zeroBudget()
+   {
+      // setup
+      FlightScheduler scheduler;
+      for (int i = 0; i < 100; i++)
+         scheduler.launch(45.0 + i * 0.1, 827.0);
+      // exercise: a budget of nothing still finishes the steps before the first clock check
+      int steps = scheduler.advance(1.0, 0.0);
+      // verify: the shells are behind and pick it up next frame
+      assert(steps < 100 * 100);
+      steps += scheduler.advance(0.0, 10.0);
+      assert(steps == 100 * 100);
+   }
+
+   void test_scheduler_fairAcrossFrames()
+   {
+      // setup: more shells than one clock check's worth of steps
+      FlightScheduler scheduler;
+      vector <int> ids;
+      for (int i = 0; i < 40; i++)
+         ids.push_back(scheduler.launch(45.0, 827.0));
+      // exercise: two frames that each run out of budget at the first clock check
+      scheduler.advance(1.0, 0.0);
+      scheduler.advance(0.0, 0.0);
+      // verify: the second frame picked up where the first stopped, so every shell moved
+      for (size_t i = 0; i < ids.size(); i++)
+         assert(scheduler.renderPosition(ids[i]).hang > 0.0);
+   }
+
+   void test_scheduler_renderBetweenTicks()
+   {
+      // setup
+      FlightScheduler scheduler;
+      int id = scheduler.launch(75.0, 827.0);
+      // exercise: a quarter of the way into the second step
+      scheduler.advance(0.0125, 1.0);
+      shellState drawn = scheduler.renderPosition(id);
+      // verify
+      ShellFlight reference(75.0, 827.0);
+      reference.step();
+      reference.step();
+      shellState expected = reference.interpolate(0.25);
+      assert(closeEnough(drawn.x, expected.x, 1e-9));
+      assert(closeEnough(drawn.y, expected.y, 1e-9));
+   }
+
+   void test_scheduler_landedShell()
+   {
+      // setup
+      FlightScheduler scheduler;
+      int id = scheduler.launch(75.0, 827.0);
+      // exercise: a minute of frames
+      for (int frame = 0; frame < 60 * 60; frame++)
+         scheduler.advance(1.0 / 60.0, 1.0);
+      // verify: drawn at the impact point, not below ground
+      assert(scheduler.hasLanded(id));
+      assert(scheduler.inFlight() == 0);
+      shellState drawn = scheduler.renderPosition(id);
+      assert(closeEnough(drawn.y, 0.0, 1e-9));
+      assert(closeEnough(drawn.x, scheduler.getSummary(id).distance, 1e-9));
+      assert(closeEnough(scheduler.getSummary(id).distance, simulateShot(75.0, 827.0).distance, 1e-9));
+      scheduler.remove(id);
+      assert(!scheduler.contains(id));
+      assert(scheduler.size() == 0);
+   }
+};
@@ -0,0 +1,165 @@
+/***********************************************************************
+ * Header File:
+ *    Test Shell Pool : Test the pooled shells and the target grid
+ * Author:
+ *    Marco Varela
+ * Summary:
+ *    Unit tests for ShellPool
+ ************************************************************************/
+
+#pragma once
+
+#include <iostream>
+#include <cassert>
+#include "shellPool.h"
+using namespace std;
+
+
+/*****************************************************
+ * TEST SHELL POOL
+ * A class that contains the Shell Pool unit tests
+ *****************************************************/
+class TestShellPool
+{
+public:
+   void run()
+   {
+      test_shellPool_full();
+      test_shellPool_staleHandle();
+      test_shellPool_ground();
+      test_shellPool_hitTarget();
+      test_shellPool_targetBehindGun();
+      test_shellPool_broadPhase();
+      cout << "All the test cases for testShellPool.h have been successfull!\n";
+   }
+private:
+
+   // utility funciton because floating point numbers are approximations
+   bool closeEnough(double value, double test, double tolerence) const
+   {
+      double difference = value - test;
+      return (difference >= -tolerence) && (difference <= tolerence);
+   }
+
+   /*****************************************************
+    * TESTING HANDLES
+    *****************************************************/
+   void test_shellPool_full()
+   {
+      // setup
+      ShellPool pool(2);
+      // exercise
+      shellHandle first = pool.launch(75.0, 827.0);
+      shellHandle second = pool.launch(75.0, 827.0);
+      shellHandle third = pool.launch(75.0, 827.0);
+      // verify
+      assert(pool.isAlive(first) && pool.isAlive(second));
+      assert(third.index == -1 && !pool.isAlive(third));
+      assert(pool.size() == 2 && pool.getCapacity() == 2);
+   }
+
+   void test_shellPool_staleHandle()
+   {
+      // setup
+      ShellPool pool(1);
+      shellHandle first = pool.launch(75.0, 827.0);
+      // exercise
+      pool.release(first);
+      shellHandle second = pool.launch(60.0, 500.0);
+      // verify: same slot, old handle no longer works
+      assert(second.index == first.index);
+      assert(!pool.isAlive(first));
+      assert(pool.isAlive(second));
+      pool.release(first);
+      assert(pool.size() == 1);
+   }
+
+   /*****************************************************
+    * TESTING HIT EVENTS
+    *****************************************************/
+   void test_shellPool_ground()
+   {
+      // setup
+      ShellPool pool(4);
+      shellHandle handle = pool.launch(75.0, 827.0);
+      hitEvent landing = {};
+      int events = 0;
+      // exercise
+      while (pool.size() > 0)
+      {
+         const vector <hitEvent> & hits = pool.step();
+         for (size_t i = 0; i < hits.size(); i++)
+         {
+            landing = hits[i];
+            events++;
+         }
+      }
+      // verify: same landing as the simulation
+      trajectorySummary expected = simulateShot(75.0, 827.0);
+      assert(events == 1);
+      assert(landing.target == -1);
+      assert(landing.shell.index == handle.index);
+      assert(closeEnough(landing.x, expected.distance, 1e-6));
+      assert(closeEnough(landing.hang, expected.hangTime, 1e-6));
+      assert(!pool.isAlive(handle));
+   }
+
+   void test_shellPool_hitTarget()
+   {
+      // setup: a target sitting on the path of the 75 degree shot
+      ShellPool pool(4, 100.0);
+      shellHandle handle = pool.launch(75.0, 827.0);
+      shellState probe = launchShell(75.0, 827.0);
+      for (int i = 0; i < 500; i++)
+         stepShell(probe, 0.01);
+      int aim = pool.addTarget(probe.x + 1.0, probe.y, 3.0);
+      pool.addTarget(probe.x, probe.y + 900.0, 3.0);
+      hitEvent hit = {};
+      // exercise
+      while (pool.isAlive(handle))
+      {
+         const vector <hitEvent> & hits = pool.step();
+         if (!hits.empty())
+            hit = hits[0];
+      }
+      // verify
+      assert(hit.target == aim);
+      assert(closeEnough(hit.x, probe.x, 4.0));
+      assert(closeEnough(hit.y, probe.y, 4.0));
+   }
+
+   void test_shellPool_targetBehindGun()
+   {
+      // setup: targets whose boxes reach into negative cells
+      ShellPool pool(2, 100.0);
+      int near = pool.addTarget(-50.0, 300.0, 80.0);
+      pool.addTarget(-300.0, 300.0, 50.0);
+      shellHandle handle = pool.launch(1.0, 300.0);
+      hitEvent hit = {};
+      hit.target = -2;
+      // exercise
+      while (pool.isAlive(handle))
+      {
+         const vector <hitEvent> & hits = pool.step();
+         if (!hits.empty())
+            hit = hits[0];
+      }
+      // verify: found through the negative columns
+      assert(hit.target == near);
+   }
+
+   void test_shellPool_broadPhase()
+   {
+      // setup: a row of targets along the ground far from the shells
+      ShellPool pool(100, 500.0);
+      for (int i = 0; i < 100; i++)
+         pool.launch(75.0, 827.0);
+      for (int i = 0; i < 200; i++)
+         pool.addTarget(20000.0 + i * 100.0, 0.0, 10.0);
+      // exercise
+      pool.step();
+      // verify: nothing near the muzzle, so nothing to test
+      assert(pool.getChecks() == 0);
+      assert(pool.size() == 100);
+   }
+};
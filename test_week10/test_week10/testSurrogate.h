@@ -0,0 +1,175 @@
+/***********************************************************************
+ * Header File:
+ *    Test Surrogate : Test the simulation and the fitted surrogate
+ * Author:
+ *    Marco Varela
+ * Summary:
+ *    Unit tests for simulateShot and the Chebyshev surrogate
+ ************************************************************************/
+
+#pragma once
+
+#include <iostream>
+#include <cassert>
+#include <fstream>
+#include <cstdio>
+#include "surrogate.h"
+using namespace std;
+
+
+/*****************************************************
+ * TEST SURROGATE
+ * A class that contains the Surrogate unit tests
+ *****************************************************/
+class TestSurrogate
+{
+public:
+   void run()
+   {
+      test_simulateShot_matchesHitTheGround();
+      test_surrogate_withinBound();
+      test_surrogate_outsideDomain();
+      test_surrogate_saveLoad();
+      test_surrogate_badFit();
+      test_surrogate_loadEmptyBox();
+      test_estimateShot_fallsBack();
+      cout << "All the test cases for testSurrogate.h have been successfull!\n";
+   }
+private:
+
+   // utility funciton because floating point numbers are approximations
+   bool closeEnough(double value, double test, double tolerence) const
+   {
+      double difference = value - test;
+      return (difference >= -tolerence) && (difference <= tolerence);
+   }
+
+   // a small fit around the 75 degree, 827 m/s shot so the tests stay quick
+   void fitSmall(Surrogate & surrogate)
+   {
+      surrogate.fit(70.0, 80.0, 800.0, 850.0, 1, 1, 6);
+   }
+
+   /*****************************************************
+    * TESTING SIMULATE SHOT
+    *****************************************************/
+   void test_simulateShot_matchesHitTheGround()
+   {
+      // exercise
+      trajectorySummary summary = simulateShot(75.0, 827.0);
+      // verify: same numbers test_hit_the_ground_8 prints
+      assert(closeEnough(summary.distance, 14571.7, 0.1));
+      assert(closeEnough(summary.hangTime, 33.5, 0.05));
+      assert(summary.apex > 1000.0);
+   }
+
+   /*****************************************************
+    * TESTING SURROGATE
+    *****************************************************/
+   void test_surrogate_withinBound()
+   {
+      // setup
+      Surrogate surrogate;
+      fitSmall(surrogate);
+      // exercise
+      surrogateEstimate estimate = surrogate.evaluate(73.3, 839.0);
+      trajectorySummary truth = simulateShot(73.3, 839.0);
+      // verify
+      assert(estimate.inDomain);
+      assert(closeEnough(estimate.value.distance, truth.distance, estimate.errorBound.distance));
+      assert(closeEnough(estimate.value.hangTime, truth.hangTime, estimate.errorBound.hangTime));
+      assert(closeEnough(estimate.value.apex, truth.apex, estimate.errorBound.apex));
+      assert(estimate.errorBound.distance < 5.0);
+   }
+
+   void test_surrogate_outsideDomain()
+   {
+      // setup
+      Surrogate surrogate;
+      fitSmall(surrogate);
+      // exercise
+      surrogateEstimate estimate = surrogate.evaluate(45.0, 827.0);
+      // verify
+      assert(!estimate.inDomain);
+      assert(!Surrogate().evaluate(75.0, 827.0).inDomain);
+   }
+
+   void test_surrogate_saveLoad()
+   {
+      // setup
+      Surrogate surrogate;
+      fitSmall(surrogate);
+      const string fileName = "testSurrogate.tmp";
+      // exercise
+      assert(surrogate.save(fileName));
+      Surrogate loaded;
+      assert(loaded.load(fileName));
+      remove(fileName.c_str());
+      // verify
+      surrogateEstimate before = surrogate.evaluate(75.0, 827.0);
+      surrogateEstimate after = loaded.evaluate(75.0, 827.0);
+      assert(closeEnough(before.value.distance, after.value.distance, 1e-9));
+      assert(closeEnough(before.errorBound.apex, after.errorBound.apex, 1e-9));
+   }
+
+   void test_surrogate_badFit()
+   {
+      // setup
+      Surrogate surrogate;
+      fitSmall(surrogate);
+      // exercise and verify
+      assert(!surrogate.fit(70.0, 80.0, 800.0, 850.0, 1, 1, -1));
+      assert(!surrogate.isFitted());
+      assert(!surrogate.fit(70.0, 80.0, 800.0, 850.0, 0, 1, 6));
+      assert(!surrogate.fit(70.0, 80.0, 800.0, 850.0, 1, 1, 17));
+      assert(!surrogate.fit(80.0, 80.0, 800.0, 850.0, 1, 1, 6));
+      assert(!surrogate.isFitted());
+      assert(!surrogate.evaluate(75.0, 827.0).inDomain);
+   }
+
+   void test_surrogate_loadEmptyBox()
+   {
+      // setup: a good fit saved with the angle range squeezed to nothing
+      Surrogate surrogate;
+      fitSmall(surrogate);
+      const string fileName = "testSurrogate.tmp";
+      assert(surrogate.save(fileName));
+      string text;
+      {
+         ifstream fin(fileName.c_str());
+         string line;
+         while (getline(fin, line))
+            text += line + "\n";
+      }
+      size_t second = text.find('\n') + 1;
+      text.replace(second, text.find(' ', second) - second, "80");
+      {
+         ofstream fout(fileName.c_str());
+         fout << text;
+      }
+      // exercise
+      Surrogate loaded;
+      bool success = loaded.load(fileName);
+      remove(fileName.c_str());
+      // verify
+      assert(!success);
+      assert(!loaded.isFitted());
+      assert(!loaded.evaluate(80.0, 827.0).inDomain);
+   }
+
+   void test_estimateShot_fallsBack()
+   {
+      // setup
+      Surrogate surrogate;
+      fitSmall(surrogate);
+      trajectorySummary loose = { 100.0, 1.0, 100.0 };
+      trajectorySummary tight = { 0.0, 0.0, 0.0 };
+      bool usedSurrogate = false;
+      // exercise and verify
+      estimateShot(surrogate, 75.0, 827.0, loose, usedSurrogate);
+      assert(usedSurrogate);
+      trajectorySummary exact = estimateShot(surrogate, 75.0, 827.0, tight, usedSurrogate);
+      assert(!usedSurrogate);
+      assert(closeEnough(exact.distance, simulateShot(75.0, 827.0).distance, 1e-9));
+   }
+};
@@ -0,0 +1,176 @@
+/***********************************************************************
+ * Header File:
+ *    Test Sweep : Test the sharded sweep and the merge step
+ * Author:
+ *    Marco Varela
+ * Summary:
+ *    Unit tests for the sweep shards and mergeShards
+ ************************************************************************/
+
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <cassert>
+#include <cstdio>
+#include "sweep.h"
+using namespace std;
+
+
+/*****************************************************
+ * TEST SWEEP
+ * A class that contains the Sweep unit tests
+ *****************************************************/
+class TestSweep
+{
+public:
+   void run()
+   {
+      test_shardRange_coversEverything();
+      test_sweepPoint_corners();
+      test_mergeShards_matchesOneShard();
+      test_mergeShards_dropsRepeats();
+      test_runShardedSweep_matchesOneShard();
+      cout << "All the test cases for testSweep.h have been successfull!\n";
+   }
+private:
+
+   // utility funciton because floating point numbers are approximations
+   bool closeEnough(double value, double test, double tolerence) const
+   {
+      double difference = value - test;
+      return (difference >= -tolerence) && (difference <= tolerence);
+   }
+
+   // read a whole file so two tables can be compared
+   string readAll(const string & fileName)
+   {
+      ifstream fin(fileName.c_str());
+      string text;
+      string line;
+      while (getline(fin, line))
+         text += line + "\n";
+      return text;
+   }
+
+   sweepSpec smallSpec()
+   {
+      sweepSpec spec = { 60.0, 80.0, 3, 300.0, 400.0, 2 };
+      return spec;
+   }
+
+   /*****************************************************
+    * TESTING SHARDS
+    *****************************************************/
+   void test_shardRange_coversEverything()
+   {
+      // setup
+      long total = 1001;
+      long expected = 0;
+      // exercise and verify: the shards butt up against each other
+      for (int shard = 0; shard < 7; shard++)
+      {
+         long first;
+         long last;
+         shardRange(total, shard, 7, first, last);
+         assert(first == expected);
+         assert(last >= first);
+         expected = last;
+      }
+      assert(expected == total);
+   }
+
+   void test_sweepPoint_corners()
+   {
+      // setup
+      sweepSpec spec = smallSpec();
+      double angle;
+      double muzzleVelocity;
+      // exercise and verify
+      sweepPoint(spec, 0, angle, muzzleVelocity);
+      assert(closeEnough(angle, 60.0, 1e-9) && closeEnough(muzzleVelocity, 300.0, 1e-9));
+      sweepPoint(spec, 3, angle, muzzleVelocity);
+      assert(closeEnough(angle, 70.0, 1e-9) && closeEnough(muzzleVelocity, 400.0, 1e-9));
+      sweepPoint(spec, sweepSize(spec) - 1, angle, muzzleVelocity);
+      assert(closeEnough(angle, 80.0, 1e-9) && closeEnough(muzzleVelocity, 400.0, 1e-9));
+   }
+
+   /*****************************************************
+    * TESTING MERGE
+    *****************************************************/
+   void test_mergeShards_matchesOneShard()
+   {
+      // setup
+      sweepSpec spec = smallSpec();
+      assert(runShard(spec, 0, 1, "testSweep.whole"));
+      assert(runShard(spec, 2, 3, "testSweep.part2"));
+      assert(runShard(spec, 0, 3, "testSweep.part0"));
+      assert(runShard(spec, 1, 3, "testSweep.part1"));
+      vector <string> whole(1, "testSweep.whole");
+      vector <string> parts;
+      parts.push_back("testSweep.part2");
+      parts.push_back("testSweep.part0");
+      parts.push_back("testSweep.part1");
+      // exercise
+      assert(mergeShards(whole, "testSweep.expected"));
+      assert(mergeShards(parts, "testSweep.merged"));
+      // verify: the same bytes no matter how it was cut
+      assert(readAll("testSweep.merged") == readAll("testSweep.expected"));
+      // teardown
+      remove("testSweep.whole");
+      remove("testSweep.part0");
+      remove("testSweep.part1");
+      remove("testSweep.part2");
+      remove("testSweep.expected");
+      remove("testSweep.merged");
+   }
+
+   void test_mergeShards_dropsRepeats()
+   {
+      // setup: the same shard twice, as if a worker was retried
+      sweepSpec spec = smallSpec();
+      assert(runShard(spec, 0, 2, "testSweep.part0"));
+      vector <string> parts(2, "testSweep.part0");
+      // exercise
+      assert(mergeShards(parts, "testSweep.merged"));
+      // verify: a header plus one row per index
+      ifstream fin("testSweep.merged");
+      string line;
+      int lines = 0;
+      while (getline(fin, line))
+         lines++;
+      fin.close();
+      assert(lines == 1 + 3);
+      assert(!mergeShards(vector <string>(1, "testSweep.missing"), "testSweep.merged"));
+      // teardown
+      remove("testSweep.part0");
+      remove("testSweep.merged");
+   }
+
+   /*****************************************************
+    * TESTING SEVERAL PROCESSES
+    *****************************************************/
+   void test_runShardedSweep_matchesOneShard()
+   {
+      // setup: the workers are this program started again in shard mode
+      ofstream fout("testSweep.spec");
+      fout << "angle 60 80 3\nvelocity 300 400 2\n";
+      fout.close();
+      sweepSpec spec;
+      assert(readSweepSpec("testSweep.spec", spec));
+      assert(sweepSize(spec) == 6);
+      assert(runShard(spec, 0, 1, "testSweep.whole"));
+      assert(mergeShards(vector <string>(1, "testSweep.whole"), "testSweep.expected"));
+      // exercise
+      assert(runShardedSweep(programPath(""), "testSweep.spec", 3, "testSweep.merged"));
+      // verify: the same table, and no shard files left behind
+      assert(readAll("testSweep.merged") == readAll("testSweep.expected"));
+      assert(!ifstream("testSweep.merged.shard0").is_open());
+      assert(!ifstream("testSweep.merged.shard2").is_open());
+      // teardown
+      remove("testSweep.spec");
+      remove("testSweep.whole");
+      remove("testSweep.expected");
+      remove("testSweep.merged");
+   }
+};
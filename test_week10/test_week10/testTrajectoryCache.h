@@ -0,0 +1,171 @@
+/***********************************************************************
+ * Header File:
+ *    Test Trajectory Cache : Test the memoization cache
+ * Author:
+ *    Marco Varela
+ * Summary:
+ *    Unit tests for TrajectoryCache
+ ************************************************************************/
+
+#pragma once
+
+#include <iostream>
+#include <cassert>
+#include <thread>
+#include "trajectoryCache.h"
+using namespace std;
+
+
+/*****************************************************
+ * TEST TRAJECTORY CACHE
+ * A class that contains the Trajectory Cache unit tests
+ *****************************************************/
+class TestTrajectoryCache
+{
+public:
+   void run()
+   {
+      test_cache_hitAfterMiss();
+      test_cache_quantized();
+      test_cache_keyedOnMetAndProfile();
+      test_cache_fliesRoundedMet();
+      test_cache_evicts();
+      test_cache_bounded();
+      test_cache_threads();
+      cout << "All the test cases for testTrajectoryCache.h have been successfull!\n";
+   }
+private:
+
+   // utility funciton because floating point numbers are approximations
+   bool closeEnough(double value, double test, double tolerence) const
+   {
+      double difference = value - test;
+      return (difference >= -tolerence) && (difference <= tolerence);
+   }
+
+   /*****************************************************
+    * TESTING LOOKUPS
+    *****************************************************/
+   void test_cache_hitAfterMiss()
+   {
+      // setup
+      TrajectoryCache cache;
+      // exercise
+      trajectorySummary first = cache.shot(75.0, 827.0);
+      trajectorySummary second = cache.shot(75.0, 827.0);
+      // verify
+      cacheStatistics statistics = cache.getStatistics();
+      assert(statistics.misses == 1 && statistics.hits == 1 && statistics.evictions == 0);
+      assert(closeEnough(first.distance, simulateShot(75.0, 827.0).distance, 1e-9));
+      assert(closeEnough(second.distance, first.distance, 1e-9));
+   }
+
+   void test_cache_quantized()
+   {
+      // setup
+      TrajectoryCache cache(64, 4, 0.1, 1.0);
+      // exercise: both round to 75.0 degrees and 827 m/s
+      trajectorySummary first = cache.shot(75.04, 827.3);
+      trajectorySummary second = cache.shot(74.96, 826.7);
+      // verify
+      assert(cache.getStatistics().hits == 1);
+      assert(closeEnough(first.distance, second.distance, 1e-9));
+      assert(closeEnough(first.distance, simulateShot(75.0, 827.0).distance, 1e-6));
+   }
+
+   void test_cache_keyedOnMetAndProfile()
+   {
+      // setup
+      TrajectoryCache cache;
+      metData standard = { 1.0, 1.0 };
+      metData heavy = { 1.05, 1.0 };
+      cache.shot(75.0, 827.0);
+      // exercise
+      cache.shot(75.0, 827.0, 1);
+      setMetData(heavy);
+      trajectorySummary heavier = cache.shot(75.0, 827.0);
+      setMetData(standard);
+      // verify
+      assert(cache.getStatistics().misses == 3);
+      assert(heavier.distance < cache.shot(75.0, 827.0).distance);
+      assert(cache.getStatistics().hits == 1);
+   }
+
+   void test_cache_fliesRoundedMet()
+   {
+      // setup: met data that rounds to a standard day
+      TrajectoryCache cache(64, 4, 0.001, 0.01, 0.01);
+      metData standard = { 1.0, 1.0 };
+      metData close = { 1.004, 0.998 };
+      // exercise
+      setMetData(close);
+      trajectorySummary cached = cache.shot(75.0, 827.0);
+      setMetData(standard);
+      // verify: flown under the rounded met data that makes up the key
+      assert(closeEnough(cached.distance, simulateShot(75.0, 827.0).distance, 1e-9));
+      assert(cache.shot(75.0, 827.0).distance == cached.distance);
+      assert(cache.getStatistics().hits == 1);
+   }
+
+   void test_cache_evicts()
+   {
+      // setup: one shard of two entries
+      TrajectoryCache cache(2, 1);
+      cache.shot(60.0, 300.0);
+      cache.shot(61.0, 300.0);
+      cache.shot(60.0, 300.0);   // now 61 is the oldest
+      // exercise
+      cache.shot(62.0, 300.0);
+      // verify
+      assert(cache.getStatistics().evictions == 1);
+      assert(cache.size() == 2);
+      cache.resetStatistics();
+      cache.shot(60.0, 300.0);
+      cache.shot(61.0, 300.0);
+      assert(cache.getStatistics().hits == 1 && cache.getStatistics().misses == 1);
+      cache.clear();
+      assert(cache.size() == 0);
+   }
+
+   void test_cache_bounded()
+   {
+      // setup: more shards than entries, and a capacity that does not divide evenly
+      TrajectoryCache few(10, 16);
+      TrajectoryCache uneven(10, 4);
+      // exercise
+      for (int i = 0; i < 40; i++)
+      {
+         few.shot(40.0 + i, 300.0);
+         uneven.shot(40.0 + i, 300.0);
+      }
+      // verify: never more than the capacity, and most of it is used
+      assert(few.size() <= 10 && few.size() >= 8);
+      assert(uneven.size() <= 10 && uneven.size() >= 8);
+   }
+
+   /*****************************************************
+    * TESTING THREADS
+    *****************************************************/
+   static void askRepeatedly(TrajectoryCache * cache, int offset)
+   {
+      for (int i = 0; i < 200; i++)
+         cache->shot(60.0 + (i + offset) % 8, 300.0);
+   }
+
+   void test_cache_threads()
+   {
+      // setup
+      TrajectoryCache cache(64, 8);
+      // exercise
+      vector <thread> threads;
+      for (int i = 0; i < 4; i++)
+         threads.push_back(thread(askRepeatedly, &cache, i));
+      for (size_t i = 0; i < threads.size(); i++)
+         threads[i].join();
+      // verify: every request counted, at most one fill per key per thread
+      cacheStatistics statistics = cache.getStatistics();
+      assert(statistics.hits + statistics.misses == 4 * 200);
+      assert(statistics.misses >= 8 && statistics.misses <= 8 * 4);
+      assert(cache.size() == 8);
+   }
+};
@@ -0,0 +1,136 @@
+/***********************************************************************
+ * Header File:
+ *    Test Worker Pool : Test the pinned worker pool and table replicas
+ * Author:
+ *    Marco Varela
+ * Summary:
+ *    Unit tests for WorkerPool, the topology parser and useLookupTables
+ ************************************************************************/
+
+#pragma once
+
+#include <iostream>
+#include <cassert>
+#include "workerPool.h"
+using namespace std;
+
+
+/*****************************************************
+ * TEST WORKER POOL
+ * A class that contains the Worker Pool unit tests
+ *****************************************************/
+class TestWorkerPool
+{
+public:
+   void run()
+   {
+      test_parseCpuList();
+      test_detectTopology();
+      test_useLookupTables();
+      test_workerPool_sweep();
+      test_workerPool_emptyTopology();
+      cout << "All the test cases for testWorkerPool.h have been successfull!\n";
+   }
+private:
+
+   // utility funciton because floating point numbers are approximations
+   bool closeEnough(double value, double test, double tolerence) const
+   {
+      double difference = value - test;
+      return (difference >= -tolerence) && (difference <= tolerence);
+   }
+
+   /*****************************************************
+    * TESTING THE TOPOLOGY
+    *****************************************************/
+   void test_parseCpuList()
+   {
+      // exercise
+      vector <int> cpus = parseCpuList("0-3,8-9,12");
+      // verify
+      assert(cpus.size() == 7);
+      assert(cpus[0] == 0 && cpus[3] == 3 && cpus[4] == 8 && cpus[6] == 12);
+      assert(parseCpuList("").empty());
+   }
+
+   void test_detectTopology()
+   {
+      // exercise
+      cpuTopology topology = detectTopology();
+      // verify: always at least one node with a CPU on it
+      assert(!topology.nodes.empty());
+      assert(!topology.nodes[0].empty());
+   }
+
+   /*****************************************************
+    * TESTING THE REPLICAS
+    *****************************************************/
+   void test_useLookupTables()
+   {
+      // setup: a copy with twice the density everywhere
+      lookupTables replica = standardTables();
+      for (size_t i = 0; i < replica.densities.size(); i++)
+         replica.densities[i].y *= 2.0;
+      double shared = densityFromAltitude(1000.0);
+      // exercise
+      useLookupTables(&replica);
+      double copied = densityFromAltitude(1000.0);
+      useLookupTables(NULL);
+      // verify
+      assert(closeEnough(copied, shared * 2.0, 1e-12));
+      assert(closeEnough(densityFromAltitude(1000.0), shared, 1e-12));
+   }
+
+   /*****************************************************
+    * TESTING THE POOL
+    *****************************************************/
+   void test_workerPool_sweep()
+   {
+      // setup: pretend there are two sockets, using the one CPU every machine has
+      cpuTopology topology;
+      topology.nodes.push_back(vector <int>(1, 0));
+      topology.nodes.push_back(vector <int>(1, 0));
+      WorkerPool pool(4, true, topology);
+      sweepSpec spec = { 60.0, 80.0, 5, 300.0, 500.0, 3 };
+      vector <trajectorySummary> results;
+      // exercise
+      pool.sweep(spec, results, 2);
+      // verify: the same answers as one thread, every shot counted once
+      assert((long)results.size() == sweepSize(spec));
+      for (long index = 0; index < sweepSize(spec); index++)
+      {
+         double angle;
+         double muzzleVelocity;
+         sweepPoint(spec, index, angle, muzzleVelocity);
+         assert(closeEnough(results[index].distance, simulateShot(angle, muzzleVelocity).distance, 1e-9));
+      }
+      long shots = 0;
+      for (int worker = 0; worker < pool.getWorkers(); worker++)
+      {
+         shots += pool.getCounters()[worker].shots;
+         assert(pool.getCounters()[worker].node == worker % 2);
+      }
+      assert(shots == sweepSize(spec));
+      assert(pool.getNodes() == 2);
+   }
+
+   void test_workerPool_emptyTopology()
+   {
+      // setup: a node with no CPUs, and no nodes at all
+      cpuTopology holes;
+      holes.nodes.push_back(vector <int>());
+      holes.nodes.push_back(vector <int>(1, 0));
+      cpuTopology none;
+      WorkerPool skipsEmpty(2, false, holes);
+      WorkerPool fallsBack(1, false, none);
+      sweepSpec spec = { 60.0, 80.0, 2, 300.0, 500.0, 2 };
+      vector <trajectorySummary> results;
+      // exercise and verify: the empty node is dropped, no nodes means detectTopology
+      assert(skipsEmpty.getNodes() == 1);
+      skipsEmpty.sweep(spec, results);
+      assert(skipsEmpty.getCounters()[1].node == 0);
+      assert(fallsBack.getNodes() >= 1);
+      fallsBack.sweep(spec, results);
+      assert(closeEnough(results[3].distance, simulateShot(80.0, 500.0).distance, 1e-9));
+   }
+};
@@ -1,10 +1,123 @@
 // test_week10.cpp : This file contains the 'main' function. Program execution begins and ends there.
 //
+// With no arguments the unit tests run. The offline tools are picked by the first argument:
+//    test_week10 fit <file>                             fit the surrogate over the howitzer's envelope and save it
+//    test_week10 sweep <spec> <processes> <file>        run a sweep over several worker processes and merge it
+//    test_week10 shard <spec> <shard> <shards> <file>   one worker's part of a sweep
+//    test_week10 merge <file> <shard files...>          combine shard files into one sorted table
+//    test_week10 converge [meters] [seconds]            chart error against wall time for each way of stepping
+//    test_week10 pool <spec> [workers]                  run a sweep on pinned threads and show each one's throughput
 
 #include <iostream>
+#include <string>
+#include <cstdlib>
+#include <iomanip>
 #include "test.h"
+#include "surrogate.h"
+#include "sweep.h"
+#include "convergence.h"
+#include "dragTable.h"
+#include "workerPool.h"
 
-int main()
+int main(int argc, char ** argv)
 {
-   testRunner();
+   if (argc < 2)
+   {
+      testRunner();
+      return 0;
+   }
+
+   string tool = argv[1];
+   if (tool == "fit" && argc == 3)
+   {
+      Surrogate surrogate;
+      surrogate.fit(10.0, 80.0, 200.0, 900.0, 7, 7, 8);
+      if (!surrogate.save(argv[2]))
+      {
+         cout << "Unable to write " << argv[2] << endl;
+         return 1;
+      }
+      cout << "Surrogate saved to " << argv[2] << endl;
+      return 0;
+   }
+
+   if (tool == "sweep" && argc == 5)
+   {
+      // the workers are this same program started again in shard mode
+      if (!runShardedSweep(programPath(argv[0]), argv[2], atoi(argv[3]), argv[4]))
+      {
+         cout << "The sweep did not finish\n";
+         return 1;
+      }
+      cout << "Sweep saved to " << argv[4] << endl;
+      return 0;
+   }
+
+   if (tool == "shard" && argc == 6)
+   {
+      sweepSpec spec;
+      if (!readSweepSpec(argv[2], spec))
+      {
+         cout << "Unable to read " << argv[2] << endl;
+         return 1;
+      }
+      return runShard(spec, atoi(argv[3]), atoi(argv[4]), argv[5]) ? 0 : 1;
+   }
+
+   if (tool == "merge" && argc >= 4)
+   {
+      vector <string> inputs(argv + 3, argv + argc);
+      if (!mergeShards(inputs, argv[2]))
+      {
+         cout << "Unable to merge into " << argv[2] << endl;
+         return 1;
+      }
+      return 0;
+   }
+
+   if (tool == "converge" && argc <= 4)
+   {
+      double distanceTolerance = argc > 2 ? atof(argv[2]) : 1.0;
+      double hangTimeTolerance = argc > 3 ? atof(argv[3]) : 0.01;
+      vector <convergenceResult> results = runConvergence(defaultConvergenceShots(),
+                                                          defaultConvergenceVariants(),
+                                                          defaultConvergenceIntervals());
+      printConvergence(results, distanceTolerance, hangTimeTolerance, cout);
+
+      dragTableError error = defaultDragTable().measureError(100000);
+      cout << "dragTable against the full drag chain: worst " << error.maximum * 100.0
+           << "% at " << error.worstAltitude << " m and " << error.worstSpeed << " m/s, mean "
+           << error.mean * 100.0 << "%\n";
+      return 0;
+   }
+
+   if (tool == "pool" && (argc == 3 || argc == 4))
+   {
+      sweepSpec spec;
+      if (!readSweepSpec(argv[2], spec))
+      {
+         cout << "Unable to read " << argv[2] << endl;
+         return 1;
+      }
+      WorkerPool pool(argc == 4 ? atoi(argv[3]) : 0);
+      vector <trajectorySummary> results;
+      pool.sweep(spec, results);
+
+      double total = 0.0;
+      cout << "worker  node  cpu   shots   shots/s\n";
+      for (int worker = 0; worker < pool.getWorkers(); worker++)
+      {
+         const workerCounters & counters = pool.getCounters()[worker];
+         cout << setw(6) << worker << setw(6) << counters.node << setw(5) << counters.cpu
+              << setw(8) << counters.shots << setw(10) << (long)counters.shotsPerSecond << '\n';
+         total += counters.shotsPerSecond;
+      }
+      cout << "total shots/s " << (long)total << " on " << pool.getNodes() << " node(s)\n";
+      return 0;
+   }
+
+   cout << "Usage: test_week10 [fit <file> | sweep <spec> <processes> <file> |\n"
+        << "                    shard <spec> <shard> <shards> <file> | merge <file> <shard files...> |\n"
+        << "                    converge [meters] [seconds] | pool <spec> [workers]]\n";
+   return 1;
 }
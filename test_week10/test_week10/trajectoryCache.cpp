@@ -0,0 +1,166 @@
+/******************************
+* Authors:
+* Marco Varela
+* Purpose:
+* The sharded, bounded trajectory cache
+*******************************/
+
+#include "trajectoryCache.h"
+using namespace std;
+
+
+/**************************************
+CACHE KEY HASH
+***************************************/
+size_t cacheKeyHash::operator () (const cacheKey & key) const
+{
+   // combine the fields the way boost::hash_combine does
+   size_t seed = hash <long long>()(key.angle);
+   seed ^= hash <long long>()(key.muzzleVelocity) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+   seed ^= hash <long long>()(key.densityFactor) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+   seed ^= hash <long long>()(key.speedOfSoundFactor) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+   seed ^= hash <int>()(key.profile) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+   return seed;
+}
+
+
+/**************************************
+TRAJECTORY CACHE : CONSTRUCTOR
+***************************************/
+TrajectoryCache::TrajectoryCache(size_t capacity, int shards,
+                                 double angleQuantum, double velocityQuantum, double metQuantum) :
+   angleQuantum(angleQuantum), velocityQuantum(velocityQuantum), metQuantum(metQuantum),
+   hits(0), misses(0), evictions(0)
+{
+   // never more shards than entries, and the remainder spread over the
+   // first shards, so the shards add up to exactly the capacity
+   if (capacity < 1)
+      capacity = 1;
+   size_t count = shards < 1 ? 1 : (size_t)shards;
+   if (count > capacity)
+      count = capacity;
+   this->shards = vector <shard>(count);
+   for (size_t i = 0; i < count; i++)
+      this->shards[i].capacity = capacity / count + (i < capacity % count ? 1 : 0);
+}
+
+
+/**************************************
+TRAJECTORY CACHE : THE SHARD A KEY LIVES IN
+* From the high bits of the hash times the golden ratio. The table
+* inside the shard picks its bucket from the low bits of the same
+* hash, so using them here too would crowd a shard into few buckets
+***************************************/
+TrajectoryCache::shard & TrajectoryCache::shardOf(size_t code)
+{
+   unsigned long long mixed = (unsigned long long)code * 0x9e3779b97f4a7c15ULL;
+   return shards[(size_t)(mixed >> 32) % shards.size()];
+}
+
+
+/**************************************
+TRAJECTORY CACHE : LOOK UP OR FLY A SHOT
+***************************************/
+trajectorySummary TrajectoryCache::shot(double angle, double muzzleVelocity, int profile)
+{
+   // one read of the met data, so the key and the flight agree
+   const metData met = getMetData();
+   cacheKey key;
+   key.angle = quantize(angle, angleQuantum);
+   key.muzzleVelocity = quantize(muzzleVelocity, velocityQuantum);
+   key.densityFactor = quantize(met.densityFactor, metQuantum);
+   key.speedOfSoundFactor = quantize(met.speedOfSoundFactor, metQuantum);
+   key.profile = profile;
+
+   shard & home = shardOf(cacheKeyHash()(key));
+
+   {
+      lock_guard <mutex> guard(home.lock);
+      unordered_map <cacheKey, recentList::iterator, cacheKeyHash> ::iterator found = home.table.find(key);
+      if (found != home.table.end())
+      {
+         home.recent.splice(home.recent.begin(), home.recent, found->second);
+         hits++;
+         return found->second->second;
+      }
+   }
+
+   // Fly it without holding the lock so the other threads on this shard
+   // are not stuck behind a whole simulation. Fly the rounded inputs and
+   // the rounded met data, on this thread only, so the answer does not
+   // depend on which request got here first or on setMetData meanwhile
+   misses++;
+   metData rounded;
+   rounded.densityFactor = key.densityFactor * metQuantum;
+   rounded.speedOfSoundFactor = key.speedOfSoundFactor * metQuantum;
+   const metData * outer = useMetData(&rounded);
+   trajectorySummary summary = simulateShot(key.angle * angleQuantum, key.muzzleVelocity * velocityQuantum);
+   useMetData(outer);
+
+   lock_guard <mutex> guard(home.lock);
+   if (home.table.find(key) == home.table.end())
+   {
+      home.recent.push_front(make_pair(key, summary));
+      home.table[key] = home.recent.begin();
+      if (home.table.size() > home.capacity)
+      {
+         home.table.erase(home.recent.back().first);
+         home.recent.pop_back();
+         evictions++;
+      }
+   }
+   return summary;
+}
+
+
+/**************************************
+TRAJECTORY CACHE : STATISTICS
+***************************************/
+cacheStatistics TrajectoryCache::getStatistics() const
+{
+   cacheStatistics statistics;
+   statistics.hits = hits;
+   statistics.misses = misses;
+   statistics.evictions = evictions;
+   return statistics;
+}
+
+
+/**************************************
+TRAJECTORY CACHE : RESET STATISTICS
+***************************************/
+void TrajectoryCache::resetStatistics()
+{
+   hits = 0;
+   misses = 0;
+   evictions = 0;
+}
+
+
+/**************************************
+TRAJECTORY CACHE : EMPTY IT
+***************************************/
+void TrajectoryCache::clear()
+{
+   for (size_t i = 0; i < shards.size(); i++)
+   {
+      lock_guard <mutex> guard(shards[i].lock);
+      shards[i].recent.clear();
+      shards[i].table.clear();
+   }
+}
+
+
+/**************************************
+TRAJECTORY CACHE : ENTRIES HELD
+***************************************/
+size_t TrajectoryCache::size() const
+{
+   size_t total = 0;
+   for (size_t i = 0; i < shards.size(); i++)
+   {
+      lock_guard <mutex> guard(shards[i].lock);
+      total += shards[i].table.size();
+   }
+   return total;
+}
@@ -0,0 +1,105 @@
+/***********************************************************************
+ * Header File:
+ *    Trajectory Cache : Remember shots we have already flown
+ * Author:
+ *    Marco Varela
+ * Summary:
+ *    A bounded, thread safe cache of trajectory summaries. Inputs are
+ *    rounded to a grid so nearly identical requests share an entry,
+ *    and the shot is flown at the rounded inputs and met data so every
+ *    thread gets the same answer. The table is split into shards, each with its
+ *    own lock and its own least recently used list
+ ************************************************************************/
+
+#pragma once
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include "simulation.h"
+
+
+/*********************************************
+ * STRUCTURE - CACHE STATISTICS
+ *********************************************/
+struct cacheStatistics
+{
+   long hits;
+   long misses;
+   long evictions;
+};
+
+
+/*********************************************
+ * STRUCTURE - CACHE KEY
+ * The rounded inputs plus whatever profile the caller is using
+ *********************************************/
+struct cacheKey
+{
+   long long angle;
+   long long muzzleVelocity;
+   long long densityFactor;
+   long long speedOfSoundFactor;
+   int profile;
+
+   bool operator == (const cacheKey & rhs) const
+   {
+      return angle == rhs.angle && muzzleVelocity == rhs.muzzleVelocity &&
+         densityFactor == rhs.densityFactor && speedOfSoundFactor == rhs.speedOfSoundFactor &&
+         profile == rhs.profile;
+   }
+};
+
+
+/*********************************************
+ * STRUCTURE - CACHE KEY HASH
+ *********************************************/
+struct cacheKeyHash
+{
+   size_t operator () (const cacheKey & key) const;
+};
+
+
+/*****************************************************
+ * TRAJECTORY CACHE
+ *****************************************************/
+class TrajectoryCache
+{
+public:
+   // capacity is the most entries held over all the shards together
+   TrajectoryCache(size_t capacity = 4096, int shards = 16,
+                   double angleQuantum = 0.001, double velocityQuantum = 0.01, double metQuantum = 1e-5);
+
+   // The summary for a shot under the current met data, flying it on a miss.
+   // profile tells apart callers using different shells or simulator versions
+   trajectorySummary shot(double angle, double muzzleVelocity, int profile = 0);
+
+   cacheStatistics getStatistics() const;
+   void resetStatistics();
+   void clear();
+   size_t size() const;
+
+private:
+   typedef list <pair <cacheKey, trajectorySummary> > recentList;
+
+   // one lock, one table and one recently used list per shard
+   struct shard
+   {
+      size_t capacity;
+      mutable mutex lock;
+      recentList recent;    // front is the most recently used
+      unordered_map <cacheKey, recentList::iterator, cacheKeyHash> table;
+   };
+
+   double angleQuantum;
+   double velocityQuantum;
+   double metQuantum;
+   vector <shard> shards;
+
+   atomic <long> hits;
+   atomic <long> misses;
+   atomic <long> evictions;
+
+   shard & shardOf(size_t code);
+   long long quantize(double value, double quantum) const { return (long long)floor(value / quantum + 0.5); }
+};
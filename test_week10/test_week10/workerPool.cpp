@@ -0,0 +1,214 @@
+/******************************
+* Authors:
+* Marco Varela
+* Purpose:
+* The pinned, NUMA aware worker pool
+*******************************/
+
+#include "workerPool.h"
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+using namespace std;
+
+
+/**************************************
+PARSE A CPU LIST
+***************************************/
+vector <int> parseCpuList(const string & text)
+{
+   vector <int> cpus;
+   stringstream ranges(text);
+   string range;
+   while (getline(ranges, range, ','))
+   {
+      int first;
+      int last;
+      char dash;
+      stringstream parts(range);
+      if (!(parts >> first))
+         continue;
+      if (parts >> dash >> last)
+         for (int cpu = first; cpu <= last; cpu++)
+            cpus.push_back(cpu);
+      else
+         cpus.push_back(first);
+   }
+   return cpus;
+}
+
+
+/**************************************
+FIND THE NUMA NODES AND THEIR CPUS
+***************************************/
+cpuTopology detectTopology()
+{
+   cpuTopology topology;
+#ifdef __linux__
+   for (int node = 0; ; node++)
+   {
+      ostringstream name;
+      name << "/sys/devices/system/node/node" << node << "/cpulist";
+      ifstream fin(name.str().c_str());
+      if (fin.fail())
+         break;
+      string text;
+      getline(fin, text);
+      vector <int> cpus = parseCpuList(text);
+      // memory only nodes have no CPUs to run on
+      if (!cpus.empty())
+         topology.nodes.push_back(cpus);
+   }
+#endif
+   if (topology.nodes.empty())
+   {
+      int count = (int)thread::hardware_concurrency();
+      topology.nodes.push_back(vector <int>());
+      for (int cpu = 0; cpu < (count > 0 ? count : 1); cpu++)
+         topology.nodes[0].push_back(cpu);
+   }
+   return topology;
+}
+
+
+/**************************************
+PIN THE CALLING THREAD TO A CPU
+***************************************/
+static bool pinThread(int cpu)
+{
+#ifdef __linux__
+   cpu_set_t set;
+   CPU_ZERO(&set);
+   CPU_SET(cpu, &set);
+   return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+   return false;
+#endif
+}
+
+
+/**************************************
+WORKER POOL : CONSTRUCTOR
+* Workers are dealt out to the nodes in turn, so two workers
+* already use both sockets
+***************************************/
+WorkerPool::WorkerPool(int workers, bool pin, const cpuTopology & given) :
+   pin(pin)
+{
+   // a node with no CPUs cannot take a worker, and with no nodes at all
+   // fall back to what detectTopology would say
+   int cpus = 0;
+   for (size_t node = 0; node < given.nodes.size(); node++)
+      if (!given.nodes[node].empty())
+      {
+         topology.nodes.push_back(given.nodes[node]);
+         cpus += (int)given.nodes[node].size();
+      }
+   if (topology.nodes.empty())
+   {
+      topology = detectTopology();
+      for (size_t node = 0; node < topology.nodes.size(); node++)
+         cpus += (int)topology.nodes[node].size();
+   }
+   if (workers <= 0)
+      workers = cpus;
+
+   for (int worker = 0; worker < workers; worker++)
+   {
+      int node = worker % (int)topology.nodes.size();
+      const vector <int> & onNode = topology.nodes[node];
+      int slot = (worker / (int)topology.nodes.size()) % (int)onNode.size();
+      workerNode.push_back(node);
+      workerCpu.push_back(pin ? onNode[slot] : -1);
+   }
+   counters.resize(workers);
+
+   for (size_t node = 0; node < topology.nodes.size(); node++)
+   {
+      replicas.push_back(unique_ptr <lookupTables>());
+      replicaMade.push_back(unique_ptr <once_flag>(new once_flag));
+   }
+}
+
+
+/**************************************
+WORKER POOL : ONE WORKER'S LOOP
+***************************************/
+void WorkerPool::work(int worker, const sweepSpec & spec, atomic <long> * next, int chunkSize,
+                      vector <pair <long, trajectorySummary> > * output)
+{
+   // counted locally and stored at the end so the workers never share a cache line in the loop
+   workerCounters mine;
+   mine.cpu = (workerCpu[worker] >= 0 && pinThread(workerCpu[worker])) ? workerCpu[worker] : -1;
+   mine.node = workerNode[worker];
+   mine.chunks = 0;
+   mine.shots = 0;
+
+   // The first worker on the node copies the tables after it is pinned,
+   // so the copy is first touched, and so placed, on this node
+   int node = workerNode[worker];
+   call_once(*replicaMade[node], [this, node]() { replicas[node].reset(new lookupTables(standardTables())); });
+   useLookupTables(replicas[node].get());
+
+   // The buffer is a local, so the vector's own pointers are not on a cache
+   // line with another worker's while it grows. It is made from this
+   // thread, so its pages are on this node too. Handed over once at the end
+   long total = sweepSize(spec);
+   vector <pair <long, trajectorySummary> > buffer;
+   buffer.reserve(total / counters.size() + chunkSize);
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   for (;;)
+   {
+      long first = next->fetch_add(chunkSize);
+      if (first >= total)
+         break;
+      long last = first + chunkSize < total ? first + chunkSize : total;
+      for (long index = first; index < last; index++)
+      {
+         double angle;
+         double muzzleVelocity;
+         sweepPoint(spec, index, angle, muzzleVelocity);
+         buffer.push_back(make_pair(index, simulateShot(angle, muzzleVelocity)));
+      }
+      mine.chunks++;
+      mine.shots += last - first;
+   }
+   chrono::duration <double> elapsed = chrono::steady_clock::now() - start;
+   mine.seconds = elapsed.count();
+   mine.shotsPerSecond = mine.seconds > 0.0 ? mine.shots / mine.seconds : 0.0;
+   counters[worker] = mine;
+   output->swap(buffer);
+
+   useLookupTables(NULL);
+}
+
+
+/**************************************
+WORKER POOL : RUN A SWEEP
+***************************************/
+void WorkerPool::sweep(const sweepSpec & spec, vector <trajectorySummary> & results, int chunkSize)
+{
+   if (chunkSize < 1)
+      chunkSize = 1;
+
+   // each worker fills its own buffer and takes chunks of indexes as it goes
+   atomic <long> next(0);
+   vector <vector <pair <long, trajectorySummary> > > outputs(counters.size());
+   vector <thread> threads;
+   for (int worker = 0; worker < (int)counters.size(); worker++)
+      threads.push_back(thread(&WorkerPool::work, this, worker, cref(spec),
+                               &next, chunkSize, &outputs[worker]));
+   for (size_t i = 0; i < threads.size(); i++)
+      threads[i].join();
+
+   results.assign(sweepSize(spec), trajectorySummary());
+   for (size_t worker = 0; worker < outputs.size(); worker++)
+      for (size_t i = 0; i < outputs[worker].size(); i++)
+         results[outputs[worker][i].first] = outputs[worker][i].second;
+}
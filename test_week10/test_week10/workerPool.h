@@ -0,0 +1,85 @@
+/***********************************************************************
+ * Header File:
+ *    Worker Pool : Sweeps spread over every core of every socket
+ * Author:
+ *    Marco Varela
+ * Summary:
+ *    One thread per core, each pinned to its core. The workers on a
+ *    NUMA node read a copy of the lookup tables made by a thread on
+ *    that node and write their results into their own buffers, so
+ *    nothing they touch in the loop lives on the other socket. Each
+ *    worker counts what it did so we can see whether it scales
+ ************************************************************************/
+
+#pragma once
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include "sweep.h"
+
+
+/*********************************************
+ * STRUCTURE - CPU TOPOLOGY
+ * The CPUs on each NUMA node
+ *********************************************/
+struct cpuTopology
+{
+   vector <vector <int> > nodes;
+};
+
+
+// Read the topology from /sys on Linux. Elsewhere, or if that fails, one
+// node holding as many CPUs as the hardware reports
+cpuTopology detectTopology();
+
+
+// Parse a Linux cpulist such as "0-3,8-11"
+vector <int> parseCpuList(const string & text);
+
+
+/*********************************************
+ * STRUCTURE - WORKER COUNTERS
+ * What one worker did in the last run
+ *********************************************/
+struct workerCounters
+{
+   int cpu;             // -1 if the thread could not be pinned
+   int node;
+   long chunks;
+   long shots;
+   double seconds;      // wall time from start to the worker running dry
+   double shotsPerSecond;
+};
+
+
+/*****************************************************
+ * WORKER POOL
+ *****************************************************/
+class WorkerPool
+{
+public:
+   // workers 0 means one per CPU in the topology. Nodes with no CPUs are
+   // dropped, and a topology with none left is replaced by detectTopology
+   WorkerPool(int workers = 0, bool pin = true, const cpuTopology & topology = detectTopology());
+
+   // Fly every shot in the sweep. results is indexed like the sweep
+   void sweep(const sweepSpec & spec, vector <trajectorySummary> & results, int chunkSize = 16);
+
+   const vector <workerCounters> & getCounters() const { return counters; }
+   int getWorkers() const { return (int)counters.size(); }
+   int getNodes() const { return (int)topology.nodes.size(); }
+
+private:
+   cpuTopology topology;
+   bool pin;
+   vector <int> workerCpu;     // -1 when not pinned
+   vector <int> workerNode;
+   vector <workerCounters> counters;
+
+   // one copy of the tables per node, made by the first worker there
+   vector <unique_ptr <lookupTables> > replicas;
+   vector <unique_ptr <once_flag> > replicaMade;
+
+   void work(int worker, const sweepSpec & spec, atomic <long> * next, int chunkSize,
+             vector <pair <long, trajectorySummary> > * output);
+};